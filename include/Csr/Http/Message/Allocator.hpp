@@ -0,0 +1,144 @@
+#ifndef CSR_HTTP_MESSAGE_ALLOCATOR
+
+#include <stddef.h>
+
+/**
+ * Default size in bytes of each block allocated by an arena. May be
+ * overridden at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_ARENA_BLOCK_SIZE
+#define CSR_HTTP_MESSAGE_ARENA_BLOCK_SIZE 16384
+#endif
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Describes a memory allocator.
+ *
+ * Messages, URIs and uploaded files may be constructed with an allocator, in
+ * which case every string they hand out and every internal structure they
+ * own MUST be allocated through it.
+ *
+ * An allocator MUST outlive every object constructed with it.
+ */
+class Allocator {
+    public:
+    /**
+     * Allocate a block of memory.
+     *
+     * The block MUST be suitably aligned for any object type.
+     *
+     * @param size The size of the block in bytes.
+     * @return Pointer to the allocated block.
+     * @throws std::bad_alloc The block could not be allocated.
+     */
+    virtual void* allocate(size_t size) = 0;
+
+    /**
+     * Release a block of memory.
+     *
+     * @param pointer Pointer to a block returned by allocate(), or NULL.
+     * @param size The size of the block in bytes, as given to allocate().
+     */
+    virtual void deallocate(void* pointer, size_t size) = 0;
+
+    /**
+     * Retrieve the default allocator.
+     *
+     * The default allocator MUST use the global heap and MUST be safe to use
+     * from any thread. Objects constructed without an allocator MUST use it.
+     *
+     * @return The default allocator.
+     */
+    static Allocator* getDefault();
+
+    virtual ~Allocator();
+};
+
+/**
+ * Bump allocator that frees all of its allocations at once.
+ *
+ * An arena allocates by advancing a pointer through blocks obtained from an
+ * upstream allocator. Individual deallocations are ignored; all memory is
+ * released when the arena is reset or destroyed. A typical use is one arena
+ * per request, so that the request, its URI, headers, parameters and
+ * uploaded files are freed in one shot when the request ends.
+ *
+ *     Arena arena;
+ *     ServerRequest* request = new ServerRequest("GET", "/", params, &arena);
+ *     // ...
+ *     delete request;
+ *     arena.reset();
+ *
+ * An arena is not thread-safe; each thread SHOULD use its own.
+ */
+class Arena : public Allocator {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Create a new arena.
+     *
+     * No memory SHOULD be allocated until the first call to allocate().
+     *
+     * @param blockSize The size in bytes of each block obtained from the
+     *     upstream allocator. Allocations larger than a block MUST be given a
+     *     dedicated block.
+     * @param upstream The allocator from which blocks are obtained, or NULL
+     *     to use the default allocator.
+     */
+    explicit Arena(
+        size_t blockSize = CSR_HTTP_MESSAGE_ARENA_BLOCK_SIZE,
+        Allocator* upstream = NULL);
+
+    /**
+     * Allocate a block of memory from the arena.
+     *
+     * @param size The size of the block in bytes.
+     * @return Pointer to the allocated block.
+     * @throws std::bad_alloc The upstream allocator could not provide a block.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * Does nothing; memory is released by reset() or destruction.
+     *
+     * @param pointer Pointer to a block returned by allocate(), or NULL.
+     * @param size The size of the block in bytes.
+     */
+    void deallocate(void* pointer, size_t size);
+
+    /**
+     * Release every allocation made from the arena.
+     *
+     * Implementations SHOULD retain the first block so that a reused arena
+     * does not need to go back to the upstream allocator.
+     *
+     * Objects constructed with the arena MUST be destroyed before it is
+     * reset.
+     */
+    void reset();
+
+    /**
+     * Retrieve the number of bytes allocated from the arena since it was
+     * created or last reset.
+     *
+     * @return The number of bytes in use.
+     */
+    size_t getUsed();
+
+    /**
+     * Retrieve the number of bytes obtained from the upstream allocator.
+     *
+     * @return The number of bytes held by the arena.
+     */
+    size_t getCapacity();
+
+    ~Arena();
+};
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_ALLOCATOR
+#endif // CSR_HTTP_MESSAGE_ALLOCATOR
@@ -0,0 +1,152 @@
+#ifndef CSR_HTTP_MESSAGE_CONTENTCODING
+
+#include "Response.hpp"
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Content codings, which may be combined to describe a set of codings.
+ *
+ * @see http://tools.ietf.org/html/rfc7231#section-3.1.2.1
+ */
+enum ContentCoding {
+    /** No transformation. */
+    CODING_IDENTITY = 0,
+
+    /** The "gzip" coding. */
+    CODING_GZIP = 1,
+
+    /** The "deflate" coding. */
+    CODING_DEFLATE = 2,
+
+    /** The "br" coding. */
+    CODING_BROTLI = 4,
+
+    /** The "zstd" coding. */
+    CODING_ZSTD = 8
+};
+
+/**
+ * Select a content coding from an Accept-Encoding header value.
+ *
+ * The coding with the highest quality value among `supported` MUST be
+ * selected. Among codings of equal quality, CODING_BROTLI, CODING_ZSTD,
+ * CODING_GZIP and CODING_DEFLATE SHOULD be preferred in that order.
+ *
+ * An empty value MUST select CODING_IDENTITY. Message::getHeaderLine()
+ * returns an empty string both for an absent and an empty header, and
+ * clients that send neither (e.g., health checks) MUST NOT be sent a coding
+ * they never asked for.
+ *
+ * @see http://tools.ietf.org/html/rfc7231#section-5.3.4
+ * @param acceptEncoding The Accept-Encoding header value.
+ * @param supported The ContentCoding values available, combined.
+ * @return The selected content coding, or CODING_IDENTITY if none of
+ *     `supported` is acceptable.
+ */
+ContentCoding negotiateContentCoding(
+    const char* acceptEncoding,
+    int supported = CODING_GZIP | CODING_DEFLATE | CODING_BROTLI | CODING_ZSTD);
+
+/**
+ * Retrieve the name of a content coding.
+ *
+ * @param coding The content coding.
+ * @return The coding name as used in the Content-Encoding header (e.g.,
+ *     "gzip"), or a null-terminated string for CODING_IDENTITY.
+ */
+const char* getContentCodingName(ContentCoding coding);
+
+/**
+ * Retrieve the stream filter that compresses with a content coding.
+ *
+ * @param coding The content coding.
+ * @return The encoding stream filter, or STREAM_FILTER_NONE for
+ *     CODING_IDENTITY.
+ */
+StreamFilter getEncodeFilter(ContentCoding coding);
+
+/**
+ * Retrieve the stream filter that decompresses a content coding.
+ *
+ * @param coding The content coding.
+ * @return The decoding stream filter, or STREAM_FILTER_NONE for
+ *     CODING_IDENTITY.
+ */
+StreamFilter getDecodeFilter(ContentCoding coding);
+
+/**
+ * Compress the body of a response according to a request.
+ *
+ * The coding MUST be negotiated from the Accept-Encoding header of
+ * `request`. "Accept-Encoding" MUST be added to the Vary header of
+ * `response`, whether or not a coding is applied.
+ *
+ * Responses that MUST NOT carry a body, with a 1xx, 204 or 304 status code,
+ * and responses for which Message::hasBody() returns false, MUST only have
+ * their Vary header updated. The body of a 206 response MUST NOT be
+ * re-encoded either, as its Content-Range refers to the unencoded
+ * representation.
+ *
+ * If a coding is selected and `response` has no Content-Encoding header, the
+ * body of `response` MUST be replaced by a stream that compresses it when
+ * read, the Content-Encoding header MUST be set, and the Content-Length
+ * header MUST be removed. The compressing stream and the original body MUST
+ * remain valid as long as the response, and be released with it.
+ *
+ * As the compressed size is not known in advance, the body MUST then be
+ * framed otherwise: "chunked" MUST be set as the Transfer-Encoding header if
+ * the protocol version of `request` is HTTP/1.1 or later (see
+ * Message::getVersionId()), and "close" as the Connection header if not.
+ * The protocol version of `response` MUST NOT be considered, as a server
+ * usually answers HTTP/1.0 clients with an HTTP/1.1 response.
+ *
+ *     compressBody(request, response);
+ *     ResponseWriter writer(response);
+ *     // ... write the response ...
+ *     if (writer.requiresClose()) {
+ *         closeConnection(fd);
+ *     }
+ *
+ * @param request The request whose Accept-Encoding header is negotiated.
+ * @param response The response whose body is to be compressed.
+ * @param supported The ContentCoding values available, combined.
+ * @return The content coding applied, or CODING_IDENTITY if none.
+ * @throws std::runtime_error The body could not be compressed.
+ */
+ContentCoding compressBody(
+    Message* request,
+    Response* response,
+    int supported = CODING_GZIP | CODING_DEFLATE | CODING_BROTLI | CODING_ZSTD);
+
+/**
+ * Open a precompressed sibling of a file, if one is acceptable.
+ *
+ * The siblings "<filename>.br", "<filename>.zst" and "<filename>.gz" are
+ * considered for CODING_BROTLI, CODING_ZSTD and CODING_GZIP respectively.
+ * The acceptable sibling that exists and is preferred by
+ * negotiateContentCoding() MUST be opened; if there is none, `filename`
+ * itself MUST be opened.
+ *
+ * Callers MUST set the Content-Encoding and Vary headers according to the
+ * coding returned.
+ *
+ * @see Stream(const char*, const char*, StreamBackend)
+ * @param filename The filename of the uncompressed file.
+ * @param acceptEncoding The Accept-Encoding header value.
+ * @param coding Receives the content coding of the opened file.
+ * @param backend The resource that will back the stream.
+ * @return A new stream owned by the caller, opened with mode "rb".
+ * @throws std::runtime_error No file can be opened.
+ */
+Stream* openPrecompressed(
+    const char* filename,
+    const char* acceptEncoding,
+    ContentCoding* coding,
+    StreamBackend backend = STREAM_BACKEND_FILE);
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_CONTENTCODING
+#endif // CSR_HTTP_MESSAGE_CONTENTCODING
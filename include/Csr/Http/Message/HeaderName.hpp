@@ -0,0 +1,216 @@
+#ifndef CSR_HTTP_MESSAGE_HEADERNAME
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Identifiers for well-known header field names.
+ *
+ * Implementations SHOULD intern these names when headers are stored, so
+ * that lookups of well-known headers compare integer identifiers rather than
+ * strings.
+ *
+ * @see http://www.iana.org/assignments/message-headers/message-headers.xhtml
+ */
+enum HeaderId {
+    /** The header name is not a well-known header name. */
+    HEADER_UNKNOWN = 0,
+
+    HEADER_ACCEPT,
+    HEADER_ACCEPT_ENCODING,
+    HEADER_ACCEPT_LANGUAGE,
+    HEADER_AUTHORIZATION,
+    HEADER_CACHE_CONTROL,
+    HEADER_CONNECTION,
+    HEADER_CONTENT_ENCODING,
+    HEADER_CONTENT_LENGTH,
+    HEADER_CONTENT_TYPE,
+    HEADER_COOKIE,
+    HEADER_DATE,
+    HEADER_ETAG,
+    HEADER_EXPECT,
+    HEADER_HOST,
+    HEADER_IF_MODIFIED_SINCE,
+    HEADER_IF_NONE_MATCH,
+    HEADER_LAST_MODIFIED,
+    HEADER_LOCATION,
+    HEADER_ORIGIN,
+    HEADER_RANGE,
+    HEADER_REFERER,
+    HEADER_SERVER,
+    HEADER_SET_COOKIE,
+    HEADER_TRAILER,
+    HEADER_TRANSFER_ENCODING,
+    HEADER_UPGRADE,
+    HEADER_USER_AGENT,
+    HEADER_VARY,
+
+    /** The number of header identifiers, including HEADER_UNKNOWN. */
+    HEADER_ID_COUNT
+};
+
+/**
+ * Resolve a header field name to its well-known identifier.
+ *
+ * The comparison MUST be case-insensitive. Implementations SHOULD resolve the
+ * name using a precomputed perfect hash, so that no more than one string
+ * comparison is performed.
+ *
+ * @param name Case-insensitive header field name, which need not be
+ *     null-terminated.
+ * @param length The length of `name` in bytes.
+ * @return The identifier of the header name, or HEADER_UNKNOWN if the name is
+ *     not a well-known header name.
+ */
+HeaderId getHeaderId(const char* name, size_t length);
+
+/**
+ * Retrieve the canonical name of a well-known header.
+ *
+ * @param id The header identifier.
+ * @return The canonical header name (e.g., "Content-Length"), or a
+ *     null-terminated string for HEADER_UNKNOWN or an invalid identifier.
+ */
+const char* getHeaderIdName(HeaderId id);
+
+/**
+ * Pre-hashed, case-insensitive header field name.
+ *
+ * A header name token resolves its HeaderId and computes the hash of its
+ * case-folded name once, at construction, so that repeated lookups of the
+ * same header need not fold or hash the name again. Message implementations
+ * SHOULD store the same hash for each of their header names.
+ *
+ *     // Look up a well-known header without any string processing.
+ *     const char* length = message->getHeaderLine(HeaderName::ContentLength);
+ *
+ *     // Build a token once for a custom header and reuse it.
+ *     static const HeaderName requestId("X-Request-Id");
+ *     const char* id = message->getHeaderLine(requestId);
+ *
+ * The static constants below are dynamically initialized, so they MUST NOT
+ * be used during the static initialization of another translation unit,
+ * e.g., by a namespace-scope routing table, where they may not have been
+ * initialized yet. Such code MUST construct a token from the identifier
+ * instead, which MUST NOT depend on any other static object:
+ *
+ *     static const HeaderName contentLength(HEADER_CONTENT_LENGTH);
+ */
+class HeaderName {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Create a header name token from a null-terminated name.
+     *
+     * Implementations MAY reference `name` rather than copy it; the string
+     * MUST remain valid for the lifetime of the token.
+     *
+     * @param name Case-insensitive header field name.
+     * @throws std::runtime_error Invalid header name.
+     */
+    explicit HeaderName(const char* name);
+
+    /**
+     * Create a header name token from a name of the given length.
+     *
+     * Implementations MAY reference `name` rather than copy it; the string
+     * MUST remain valid for the lifetime of the token.
+     *
+     * @param name Case-insensitive header field name, which need not be
+     *     null-terminated.
+     * @param length The length of `name` in bytes.
+     * @throws std::runtime_error Invalid header name.
+     */
+    HeaderName(const char* name, size_t length);
+
+    /**
+     * Create a header name token for a well-known header.
+     *
+     * @param id The header identifier.
+     * @throws std::invalid_argument The identifier is HEADER_UNKNOWN or
+     *     invalid.
+     */
+    explicit HeaderName(HeaderId id);
+
+    /**
+     * Retrieve the header name as given at construction.
+     *
+     * @return The header name. The string is only null-terminated if the
+     *     name given at construction was.
+     */
+    const char* getName() const;
+
+    /**
+     * Retrieve the length of the header name.
+     *
+     * @return The length of the header name in bytes.
+     */
+    size_t getLength() const;
+
+    /**
+     * Retrieve the well-known identifier of the header name.
+     *
+     * @return The header identifier, or HEADER_UNKNOWN.
+     */
+    HeaderId getId() const;
+
+    /**
+     * Retrieve the hash of the case-folded header name.
+     *
+     * Names that are equal under a case-insensitive comparison MUST have the
+     * same hash.
+     *
+     * @return The hash of the header name.
+     */
+    uint32_t getHash() const;
+
+    /**
+     * Compares two header names without case-sensitivity.
+     *
+     * Implementations SHOULD compare identifiers and hashes before comparing
+     * names.
+     *
+     * @param other The header name to compare with.
+     * @return True if both names are equal using a case-insensitive string
+     *     comparison, false if not.
+     */
+    bool equals(const HeaderName& other) const;
+
+    static const HeaderName Accept;
+    static const HeaderName AcceptEncoding;
+    static const HeaderName AcceptLanguage;
+    static const HeaderName Authorization;
+    static const HeaderName CacheControl;
+    static const HeaderName Connection;
+    static const HeaderName ContentEncoding;
+    static const HeaderName ContentLength;
+    static const HeaderName ContentType;
+    static const HeaderName Cookie;
+    static const HeaderName Date;
+    static const HeaderName ETag;
+    static const HeaderName Expect;
+    static const HeaderName Host;
+    static const HeaderName IfModifiedSince;
+    static const HeaderName IfNoneMatch;
+    static const HeaderName LastModified;
+    static const HeaderName Location;
+    static const HeaderName Origin;
+    static const HeaderName Range;
+    static const HeaderName Referer;
+    static const HeaderName Server;
+    static const HeaderName SetCookie;
+    static const HeaderName Trailer;
+    static const HeaderName TransferEncoding;
+    static const HeaderName Upgrade;
+    static const HeaderName UserAgent;
+    static const HeaderName Vary;
+};
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_HEADERNAME
+#endif // CSR_HTTP_MESSAGE_HEADERNAME
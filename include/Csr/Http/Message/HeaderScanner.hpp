@@ -0,0 +1,105 @@
+#ifndef CSR_HTTP_MESSAGE_HEADERSCANNER
+
+#include <stddef.h>
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Implementations of the header scanning functions.
+ *
+ * Implementations SHOULD provide vectorized kernels and MUST provide the
+ * scalar kernel. The kernel MUST be selected once, at runtime, from the
+ * features of the executing CPU (e.g., using `cpuid`). If
+ * `CSR_HTTP_MESSAGE_NO_SIMD` is defined when the implementation is compiled,
+ * only the scalar kernel MUST be used.
+ */
+enum ScanKernel {
+    /** Portable byte-at-a-time kernel. */
+    SCAN_KERNEL_SCALAR = 0,
+
+    /** SSE4.2 kernel using `pcmpistri` character-range matching. */
+    SCAN_KERNEL_SSE42 = 1,
+
+    /** AVX2 kernel scanning 32 bytes at a time. */
+    SCAN_KERNEL_AVX2 = 2
+};
+
+/**
+ * Retrieve the kernel selected for the executing CPU.
+ *
+ * @return The scan kernel in use.
+ */
+ScanKernel getScanKernel();
+
+/**
+ * Measure the leading span of valid header name characters.
+ *
+ * Valid characters are those of the RFC 7230 `tchar` rule.
+ *
+ * @see http://tools.ietf.org/html/rfc7230#section-3.2.6
+ * @param data The bytes to scan, which need not be null-terminated.
+ * @param length The number of bytes in `data`.
+ * @return The offset of the first invalid character, or `length` if every
+ *     character is valid.
+ */
+size_t scanHeaderName(const char* data, size_t length);
+
+/**
+ * Measure the leading span of valid header value characters.
+ *
+ * Valid characters are those of the RFC 7230 `field-content` rule: visible
+ * characters, obs-text, spaces and horizontal tabs.
+ *
+ * @see http://tools.ietf.org/html/rfc7230#section-3.2
+ * @param data The bytes to scan, which need not be null-terminated.
+ * @param length The number of bytes in `data`.
+ * @return The offset of the first invalid character, or `length` if every
+ *     character is valid.
+ */
+size_t scanHeaderValue(const char* data, size_t length);
+
+/**
+ * Checks whether a header name is a valid RFC 7230 token.
+ *
+ * @param data The header name, which need not be null-terminated.
+ * @param length The length of the header name in bytes.
+ * @return True if the name is non-empty and valid, false if not.
+ */
+bool isValidHeaderName(const char* data, size_t length);
+
+/**
+ * Checks whether a header value is a valid RFC 7230 field value.
+ *
+ * @param data The header value, which need not be null-terminated.
+ * @param length The length of the header value in bytes.
+ * @return True if the value is valid, false if not.
+ */
+bool isValidHeaderValue(const char* data, size_t length);
+
+/**
+ * Find the first CRLF sequence.
+ *
+ * @param data The bytes to scan, which need not be null-terminated.
+ * @param length The number of bytes in `data`.
+ * @return The offset of the CR of the first CRLF, or `length` if none is
+ *     found.
+ */
+size_t findCrlf(const char* data, size_t length);
+
+/**
+ * Find the colon separating a header name from its value.
+ *
+ * Scanning MUST stop at the first CR or LF.
+ *
+ * @param data The bytes to scan, which need not be null-terminated.
+ * @param length The number of bytes in `data`.
+ * @return The offset of the first colon, or `length` if none is found before
+ *     the end of the line.
+ */
+size_t findHeaderColon(const char* data, size_t length);
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_HEADERSCANNER
+#endif // CSR_HTTP_MESSAGE_HEADERSCANNER
@@ -1,11 +1,45 @@
 #ifndef CSR_HTTP_MESSAGE_MESSAGE
 
+#include "Allocator.hpp"
+#include "HeaderName.hpp"
+#include "HeaderScanner.hpp"
 #include "Stream.hpp"
 
 namespace Csr {
 namespace Http {
 namespace Message {
 
+/**
+ * Identifiers for standard HTTP protocol versions.
+ */
+enum VersionId {
+    /** The protocol version is not a standard HTTP version. */
+    VERSION_OTHER = 0,
+
+    /** HTTP/1.0 */
+    VERSION_1_0 = 1,
+
+    /** HTTP/1.1 */
+    VERSION_1_1 = 2,
+
+    /** HTTP/2 */
+    VERSION_2 = 3,
+
+    /** HTTP/3 */
+    VERSION_3 = 4
+};
+
+/**
+ * A header name and value pair.
+ */
+struct HeaderField {
+    /** Case-insensitive header field name. */
+    const char* name;
+
+    /** Header value. */
+    const char* value;
+};
+
 /**
  * Iterates over a list of header values.
  */
@@ -65,6 +99,14 @@ class HeaderIterator {
      */
     const char* getName();
 
+    /**
+     * Gets the well-known identifier of the current header.
+     *
+     * @return Identifier of the current header, or HEADER_UNKNOWN if its
+     *     name is not a well-known header name.
+     */
+    HeaderId getId();
+
     /**
      * Get an iterator of values for the current header.
      *
@@ -78,6 +120,25 @@ class HeaderIterator {
  * from a server to a client. This interface defines the methods common to
  * each.
  *
+ * Implementations SHOULD store headers in a single contiguous buffer per
+ * message, with a small array of entries holding the offsets of each name and
+ * value within it. Well-known header names SHOULD be interned as a HeaderId
+ * so that lookups for them compare identifiers rather than strings.
+ * HeaderIterator and ValueIterator may then be implemented as indices into
+ * the entry array.
+ *
+ * The with*() methods return modified copies of a message, as in PSR-7,
+ * without modifying the original. Copies SHOULD share unchanged header
+ * storage, URIs and the body with the original by reference counting, and
+ * copy shared storage only when either message modifies it. A body stream
+ * shared between messages MUST remain valid until every message sharing it
+ * has been destroyed.
+ *
+ * The with*() methods and the destructor are virtual, and each subclass
+ * re-declares them to return its own type, so that a copy made or destroyed
+ * through a base pointer keeps the type and state of the original (e.g., a
+ * ServerRequest modified through a Request* is still a ServerRequest).
+ *
  * @see http://www.ietf.org/rfc/rfc7230.txt
  * @see http://www.ietf.org/rfc/rfc7231.txt
  */
@@ -88,10 +149,30 @@ class Message {
     /**
      * Initializes an HTTP message.
      *
-     * Messages should be initializes with a default temp stream body.
+     * Messages should be initializes with a default stream body, as created
+     * by Stream(). The body SHOULD be created lazily, on the first call to
+     * getBody(), so that messages which never use a body do not construct
+     * one.
      */
     Message();
 
+    /**
+     * Initializes an HTTP message using the given allocator.
+     *
+     * Header storage and every string returned by the message MUST be
+     * allocated through `allocator`.
+     *
+     * @param allocator The allocator to use; MUST outlive the message.
+     */
+    explicit Message(Allocator* allocator);
+
+    /**
+     * Retrieves the allocator used by the message.
+     *
+     * @return The allocator given at construction, or the default allocator.
+     */
+    Allocator* getAllocator();
+
     /**
      * Retrieves the HTTP protocol version as a string.
      *
@@ -111,6 +192,36 @@ class Message {
      */
     void setProtocolVersion(const char* version);
 
+    /**
+     * Retrieves the HTTP protocol version as an identifier.
+     *
+     * Implementations SHOULD store the identifier, so that this method needs
+     * no string comparison.
+     *
+     * @return HTTP protocol version identifier, or VERSION_OTHER if the
+     *     protocol version is not a standard HTTP version.
+     */
+    VersionId getVersionId();
+
+    /**
+     * Sets the specified standard HTTP protocol version.
+     *
+     * @param version HTTP protocol version identifier.
+     * @throws std::invalid_argument The identifier is VERSION_OTHER or
+     *     invalid.
+     */
+    void setProtocolVersion(VersionId version);
+
+    /**
+     * Sets the standard HTTP protocol version given at compile time.
+     *
+     *     message->setProtocolVersion<VERSION_1_1>();
+     *
+     * @see setProtocolVersion(VersionId)
+     */
+    template <VersionId V>
+    void setProtocolVersion() { setProtocolVersion(V); }
+
     /**
      * Retrieves all message header values.
      *
@@ -154,6 +265,16 @@ class Message {
      */
     bool hasHeader(const char* name);
 
+    /**
+     * Checks if a header exists by the given pre-hashed name.
+     *
+     * @see hasHeader(const char*)
+     * @param name Header field name token.
+     * @return True if any header names match the given header name, false if
+     *     not.
+     */
+    bool hasHeader(const HeaderName& name);
+
     /**
      * Retrieves a message header value by the given case-insensitive name.
      *
@@ -170,6 +291,15 @@ class Message {
      */
     ValueIterator getHeader(const char* name);
 
+    /**
+     * Retrieves a message header value by the given pre-hashed name.
+     *
+     * @see getHeader(const char*)
+     * @param name Header field name token.
+     * @return An iterator of string values as provided for the given header.
+     */
+    ValueIterator getHeader(const HeaderName& name);
+
     /**
      * Retrieves a comma-separated string of the values for a single header.
      *
@@ -191,6 +321,17 @@ class Message {
      */
     const char* getHeaderLine(const char* name);
 
+    /**
+     * Retrieves a comma-separated string of the values for a single header
+     * by the given pre-hashed name.
+     *
+     * @see getHeaderLine(const char*)
+     * @param name Header field name token.
+     * @return A string of values as provided for the given header
+     *     concatenated together using a comma.
+     */
+    const char* getHeaderLine(const HeaderName& name);
+
     /**
      * Set the specified header with the provided value.
      *
@@ -200,12 +341,25 @@ class Message {
      * While header names are case-insensitive, the casing of the header will
      * be preserved by this function, and returned from getHeaders().
      *
+     * Names and values SHOULD be validated with isValidHeaderName() and
+     * isValidHeaderValue().
+     *
      * @param name Case-insensitive header field name.
      * @param value Header value.
      * @throws std::runtime_error Invalid header names or values.
      */
     void setHeader(const char* name, const char* value);
 
+    /**
+     * Set the header of the given pre-hashed name with the provided value.
+     *
+     * @see setHeader(const char*, const char*)
+     * @param name Header field name token.
+     * @param value Header value.
+     * @throws std::runtime_error Invalid header values.
+     */
+    void setHeader(const HeaderName& name, const char* value);
+
     /**
      * Sets the specified header appended with the given value.
      *
@@ -213,12 +367,70 @@ class Message {
      * values will be appended to the existing list. If the header did not
      * exist previously, it will be added.
      *
+     * Names and values SHOULD be validated with isValidHeaderName() and
+     * isValidHeaderValue().
+     *
      * @param name Case-insensitive header field name to add.
      * @param value Header value.
      * @throws std::runtime_error Invalid header names or values.
      */
     void setAddedHeader(const char* name, const char* value);
 
+    /**
+     * Sets the header of the given pre-hashed name appended with the given
+     * value.
+     *
+     * @see setAddedHeader(const char*, const char*)
+     * @param name Header field name token.
+     * @param value Header value.
+     * @throws std::runtime_error Invalid header values.
+     */
+    void setAddedHeader(const HeaderName& name, const char* value);
+
+    /**
+     * Sets each of the specified headers appended with its value.
+     *
+     * The result MUST be the same as calling setAddedHeader() for each field
+     * in order, but implementations SHOULD reserve storage once for all
+     * fields, validate every name and value in a single pass, and merge
+     * fields with the same name, and with existing headers, in one sweep.
+     *
+     * If any name or value is invalid, the message MUST NOT be modified.
+     *
+     * The fields MAY reference strings owned by this message (e.g., values
+     * returned by getHeaderLine()); implementations MUST NOT release or move
+     * them until every field has been added.
+     *
+     * @see setAddedHeader(const char*, const char*)
+     * @param headers Array of header fields to add.
+     * @param count The number of fields in `headers`.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    void setAddedHeaders(const HeaderField* headers, size_t count);
+
+    /**
+     * Sets each header of another message appended with its values.
+     *
+     * Every header of the iterator MUST be added, regardless of its current
+     * position.
+     *
+     * The iterator MAY walk the headers of this same message, in which case
+     * the headers MUST be added as they were before the call, so that each
+     * value is appended exactly once. Implementations MUST snapshot the
+     * iterated headers before modifying any of them.
+     *
+     *     // Duplicate every header of the message.
+     *     message->setAddedHeaders(message->getHeaders());
+     *
+     *     // Copy the headers of an upstream response.
+     *     response->setAddedHeaders(upstream->getHeaders());
+     *
+     * @see setAddedHeaders(const HeaderField*, size_t)
+     * @param headers Iterator of headers to add.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    void setAddedHeaders(HeaderIterator headers);
+
     /**
      * Removes the specified header with it's values.
      *
@@ -228,24 +440,131 @@ class Message {
      */
     void removeHeader(const char* name);
 
+    /**
+     * Removes the header of the given pre-hashed name with it's values.
+     *
+     * @see removeHeader(const char*)
+     * @param name Header field name token to remove.
+     */
+    void removeHeader(const HeaderName& name);
+
     /**
      * Gets the body of the message.
      *
+     * A body may be read or written without blocking through its tryRead()
+     * and tryWrite() methods.
+     *
+     * If no body has been created or set, a default stream body MUST be
+     * created and returned.
+     *
      * @return The body as a stream.
      */
     Stream* getBody();
 
+    /**
+     * Checks whether the message has a body.
+     *
+     * This method MUST NOT create a body. Serializers may use it to skip
+     * the body of messages that never had one.
+     *
+     * @return True if a body has been created by getBody() or provided with
+     *     setBody(), false if not.
+     */
+    bool hasBody();
+
     /**
      * Sets the specified message body.
      *
      * The body MUST be a Stream object.
      *
+     * If no body has been created yet, this method MUST NOT create a
+     * default body before replacing it.
+     *
      * @param body The body stream.
      * @throws std::runtime_error The body is not valid.
      */
     void setBody(Stream* body);
 
-    ~Message();
+    /**
+     * Return an instance with the specified HTTP protocol version.
+     *
+     * This method MUST NOT modify the message, and MUST return a new
+     * message that is otherwise identical to this one.
+     *
+     * @see setProtocolVersion()
+     * @param version HTTP protocol version.
+     * @return A new message owned by the caller.
+     */
+    virtual Message* withProtocolVersion(const char* version);
+
+    /**
+     * Return an instance with the provided value replacing the specified
+     * header.
+     *
+     * This method MUST NOT modify the message, and MUST return a new
+     * message that is otherwise identical to this one.
+     *
+     * @see setHeader()
+     * @param name Case-insensitive header field name.
+     * @param value Header value.
+     * @return A new message owned by the caller.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    virtual Message* withHeader(const char* name, const char* value);
+
+    /**
+     * Return an instance with the specified header appended with the given
+     * value.
+     *
+     * This method MUST NOT modify the message, and MUST return a new
+     * message that is otherwise identical to this one.
+     *
+     * @see setAddedHeader()
+     * @param name Case-insensitive header field name to add.
+     * @param value Header value.
+     * @return A new message owned by the caller.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    virtual Message* withAddedHeader(const char* name, const char* value);
+
+    /**
+     * Return an instance without the specified header.
+     *
+     * This method MUST NOT modify the message, and MUST return a new
+     * message that is otherwise identical to this one.
+     *
+     * @see removeHeader()
+     * @param name Case-insensitive header field name to remove.
+     * @return A new message owned by the caller.
+     */
+    virtual Message* withoutHeader(const char* name);
+
+    /**
+     * Return an instance with the specified message body.
+     *
+     * This method MUST NOT modify the message, and MUST return a new
+     * message that is otherwise identical to this one.
+     *
+     * @see setBody()
+     * @param body The body stream.
+     * @return A new message owned by the caller.
+     * @throws std::runtime_error The body is not valid.
+     */
+    virtual Message* withBody(Stream* body);
+
+    /**
+     * Returns the message to its initial state.
+     *
+     * The protocol version, headers and body MUST be cleared as if the
+     * message had just been constructed, but header storage SHOULD retain its
+     * capacity so that reusing the message does not allocate. A default body
+     * created by the message MAY be kept and truncated rather than destroyed,
+     * but hasBody() MUST return false until getBody() or setBody() is called
+     * again.
+     */
+    void reset();
+
+    virtual ~Message();
 };
 
 }}} // Csr::Http::Message
@@ -0,0 +1,184 @@
+#ifndef CSR_HTTP_MESSAGE_METRICS
+
+#include "Stream.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Number of buckets per histogram. Bucket `i` counts values in
+ * [2^i, 2^(i+1)), bucket 0 also counts 0, and the last bucket counts every
+ * larger value. May be overridden at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_HISTOGRAM_BUCKETS
+#define CSR_HTTP_MESSAGE_HISTOGRAM_BUCKETS 32
+#endif
+
+/*
+ * Instrumentation is only recorded when CSR_HTTP_MESSAGE_ENABLE_METRICS is
+ * defined when the implementation is compiled. Otherwise, the recording
+ * macros expand to nothing, and snapshots are empty.
+ */
+#ifdef CSR_HTTP_MESSAGE_ENABLE_METRICS
+#define CSR_HTTP_MESSAGE_RECORD(histogram, value) \
+    ::Csr::Http::Message::recordMetric((histogram), (value))
+#define CSR_HTTP_MESSAGE_RECORD_STREAM(backend, read, written, syscalls) \
+    ::Csr::Http::Message::recordStreamMetric( \
+        (backend), (read), (written), (syscalls))
+#else
+#define CSR_HTTP_MESSAGE_RECORD(histogram, value) ((void) 0)
+#define CSR_HTTP_MESSAGE_RECORD_STREAM(backend, read, written, syscalls) \
+    ((void) 0)
+#endif
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Distributions recorded by the instrumentation.
+ */
+enum MetricHistogram {
+    /** Heap allocations made per message over its lifetime. */
+    METRIC_MESSAGE_ALLOCATIONS = 0,
+
+    /** Bytes allocated per message over its lifetime. */
+    METRIC_MESSAGE_BYTES,
+
+    /** Headers per message. */
+    METRIC_HEADER_COUNT,
+
+    /** Bytes of header names and values per message. */
+    METRIC_HEADER_SIZE,
+
+    /**
+     * Nanoseconds RequestParser spends parsing the request line and headers
+     * of each request.
+     */
+    METRIC_HEADER_PARSE_NS,
+
+    /** Nanoseconds spent parsing each URI. */
+    METRIC_URI_PARSE_NS,
+
+    /**
+     * Nanoseconds spent building each index of query, cookie or body
+     * parameters, excluding percent-decoding of individual values.
+     */
+    METRIC_PARAM_DECODE_NS,
+
+    /** Nanoseconds spent spooling each uploaded file. */
+    METRIC_UPLOAD_SPOOL_NS,
+
+    /** Nanoseconds spent in each UploadedFile::moveTo() call. */
+    METRIC_UPLOAD_MOVE_NS,
+
+    /** The number of histograms. */
+    METRIC_HISTOGRAM_COUNT
+};
+
+/**
+ * Distribution of recorded values.
+ */
+struct Histogram {
+    /** The number of values recorded. */
+    uint64_t count;
+
+    /** The sum of the values recorded. */
+    uint64_t sum;
+
+    /** The number of values recorded in each power-of-two bucket. */
+    uint64_t buckets[CSR_HTTP_MESSAGE_HISTOGRAM_BUCKETS];
+};
+
+/**
+ * I/O performed by the streams of one backend.
+ */
+struct StreamMetrics {
+    /** Bytes read from the underlying resources. */
+    uint64_t bytesRead;
+
+    /** Bytes written to the underlying resources. */
+    uint64_t bytesWritten;
+
+    /** System calls made, or io_uring submissions for STREAM_BACKEND_URING. */
+    uint64_t syscalls;
+};
+
+/**
+ * Totals of every metric across all threads.
+ */
+struct MetricsSnapshot {
+    /** Histograms indexed by MetricHistogram. */
+    Histogram histograms[METRIC_HISTOGRAM_COUNT];
+
+    /** Stream I/O indexed by StreamBackend. */
+    StreamMetrics streams[STREAM_BACKEND_COUNT];
+};
+
+/**
+ * Record a value in a histogram of the calling thread.
+ *
+ * Recording MUST NOT take a lock or allocate; counters SHOULD be kept per
+ * thread and only aggregated by getMetricsSnapshot(). Implementations call
+ * this through CSR_HTTP_MESSAGE_RECORD() so that it is compiled out when
+ * instrumentation is disabled.
+ *
+ * @param histogram The histogram to record in.
+ * @param value The value to record.
+ */
+void recordMetric(MetricHistogram histogram, uint64_t value);
+
+/**
+ * Record stream I/O of the calling thread.
+ *
+ * @see recordMetric()
+ * @param backend The backend of the stream that performed the I/O.
+ * @param bytesRead Bytes read from the underlying resource.
+ * @param bytesWritten Bytes written to the underlying resource.
+ * @param syscalls System calls made.
+ */
+void recordStreamMetric(
+    StreamBackend backend,
+    uint64_t bytesRead,
+    uint64_t bytesWritten,
+    uint64_t syscalls);
+
+/**
+ * Retrieve the totals of every metric across all threads.
+ *
+ * Totals MUST include threads that have exited. The snapshot MAY be slightly
+ * inconsistent with metrics being recorded concurrently.
+ *
+ * @param snapshot Receives the totals; every value is 0 if instrumentation
+ *     is disabled.
+ */
+void getMetricsSnapshot(MetricsSnapshot* snapshot);
+
+/**
+ * Reset every metric of every thread to 0.
+ */
+void resetMetrics();
+
+/**
+ * Format a snapshot in the Prometheus text exposition format.
+ *
+ * Histograms MUST be exposed as Prometheus histograms, and stream metrics as
+ * counters labelled by backend. The output is null-terminated if `length` is
+ * greater than 0, and truncated if `buffer` is too small, as with
+ * `snprintf()`.
+ *
+ * @see https://prometheus.io/docs/instrumenting/exposition_formats/
+ * @param snapshot The snapshot to format.
+ * @param buffer The buffer that will receive the output.
+ * @param length The size of `buffer` in bytes.
+ * @return The length of the complete output in bytes, excluding the
+ *     null terminator.
+ */
+size_t formatMetrics(
+    const MetricsSnapshot* snapshot,
+    char* buffer,
+    size_t length);
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_METRICS
+#endif // CSR_HTTP_MESSAGE_METRICS
@@ -0,0 +1,175 @@
+#ifndef CSR_HTTP_MESSAGE_MULTIPARTPARSER
+
+#include "Allocator.hpp"
+#include "ParseStatus.hpp"
+#include "ServerRequest.hpp"
+
+/**
+ * Default maximum size in bytes of each multipart form field that is not a
+ * file. May be overridden at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_MAX_FORM_FIELD_SIZE
+#define CSR_HTTP_MESSAGE_MAX_FORM_FIELD_SIZE 1048576
+#endif
+
+/**
+ * Default maximum combined size in bytes of the multipart form fields of a
+ * request. May be overridden at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_MAX_FORM_FIELDS_SIZE
+#define CSR_HTTP_MESSAGE_MAX_FORM_FIELDS_SIZE 8388608
+#endif
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Provides the destination streams of uploaded files.
+ */
+class UploadHandler {
+    public:
+    /**
+     * Open the stream to which an uploaded file will be written.
+     *
+     * Called once per file part, after its headers have been parsed and
+     * before any of its content is written.
+     *
+     * @param name The form field name of the part.
+     * @param clientFileName The filename as provided by the client, or a
+     *     null-terminated string.
+     * @param clientMediaType The media type as provided by the client, or a
+     *     null-terminated string.
+     * @return A writable stream, to be owned by the resulting UploadedFile, or
+     *     NULL to skip the part with UPLOAD_ERR_EXTENSION.
+     */
+    virtual Stream* open(
+        const char* name,
+        const char* clientFileName,
+        const char* clientMediaType) = 0;
+
+    virtual ~UploadHandler();
+};
+
+/**
+ * Streaming multipart/form-data parser.
+ *
+ * The request body is pushed into the parser in chunks of any size. The
+ * content of each file part MUST be written to its destination stream as it
+ * arrives, without buffering the part or the body as a whole. Boundaries
+ * SHOULD be found with a Boyer-Moore-Horspool or vectorized search.
+ *
+ * Once a file part is complete, an UploadedFile MUST be created for it with
+ * its size, error, client filename and client media type. Parts without a
+ * filename are form fields, and their values are made available through
+ * getField().
+ *
+ * Size limits MUST be enforced while parsing: as soon as a file part exceeds
+ * `maxFileSize`, or the size given by a preceding MAX_FILE_SIZE form field,
+ * the rest of the part MUST be discarded instead of written, and its
+ * UploadedFile MUST report UPLOAD_ERR_INI_SIZE or UPLOAD_ERR_FORM_SIZE
+ * respectively.
+ *
+ * Form field values are held in memory, so parse() MUST return PARSE_ERROR as
+ * soon as a field exceeds `maxFieldSize`, or all fields together exceed
+ * `maxFieldsSize`, without buffering the rest of the field.
+ *
+ * @see http://tools.ietf.org/html/rfc7578
+ */
+class MultipartParser {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Create a new multipart parser.
+     *
+     * @param boundary The boundary parameter of the Content-Type header,
+     *     without its leading dashes.
+     * @param maxFileSize Maximum size of each uploaded file in bytes, or -1
+     *     for no limit.
+     * @param maxFieldSize Maximum size in bytes of each form field value.
+     * @param maxFieldsSize Maximum combined size in bytes of all form field
+     *     names and values.
+     * @param handler The provider of destination streams, or NULL to write
+     *     each file to a default stream, as created by Stream().
+     * @param allocator The allocator with which to construct uploaded files,
+     *     or NULL to use the default allocator.
+     * @throws std::invalid_argument The boundary is empty or invalid.
+     */
+    explicit MultipartParser(
+        const char* boundary,
+        long maxFileSize = -1,
+        size_t maxFieldSize = CSR_HTTP_MESSAGE_MAX_FORM_FIELD_SIZE,
+        size_t maxFieldsSize = CSR_HTTP_MESSAGE_MAX_FORM_FIELDS_SIZE,
+        UploadHandler* handler = NULL,
+        Allocator* allocator = NULL);
+
+    /**
+     * Parse a chunk of the request body.
+     *
+     * @param data The bytes to parse.
+     * @param length The number of bytes in `data`.
+     * @return PARSE_NEED_MORE if every byte was consumed and the closing
+     *     boundary has not been reached, PARSE_DONE if it has, or PARSE_ERROR
+     *     if the body is malformed or a form field limit is exceeded.
+     */
+    ParseStatus parse(const char* data, size_t length);
+
+    /**
+     * Signals that the request body has ended.
+     *
+     * If the closing boundary has not been reached, a file part in progress
+     * MUST be completed with UPLOAD_ERR_PARTIAL.
+     *
+     * @return PARSE_DONE if the closing boundary had been reached, or
+     *     PARSE_ERROR if not.
+     */
+    ParseStatus finish();
+
+    /**
+     * Retrieve the offset reached within the last chunk given to parse().
+     *
+     * @see RequestParser::getOffset()
+     * @return Offset in bytes within the last chunk.
+     */
+    size_t getOffset();
+
+    /**
+     * Retrieve a completed uploaded file by its form field name.
+     *
+     * The parser retains ownership of the uploaded file.
+     *
+     * @param name The form field name.
+     * @return The uploaded file or NULL if none can be found.
+     */
+    UploadedFile* getUploadedFile(const char* name);
+
+    /**
+     * Retrieve the value of a completed form field by its name.
+     *
+     * @param name The form field name.
+     * @return The value of the field or a null-terminated string if none can
+     *     be found.
+     */
+    const char* getField(const char* name);
+
+    /**
+     * Attaches completed parts to a request.
+     *
+     * Every part already completed, and every part completed afterwards, MUST
+     * be attached to `request` with ServerRequest::setUploadedFile() or
+     * ServerRequest::setBodyParam(). Ownership of attached uploaded files is
+     * transferred to the request, and getUploadedFile() no longer returns
+     * them.
+     *
+     * @param request The request to attach parts to; MUST outlive the parser
+     *     or the next call to this method.
+     */
+    void attachTo(ServerRequest* request);
+
+    ~MultipartParser();
+};
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_MULTIPARTPARSER
+#endif // CSR_HTTP_MESSAGE_MULTIPARTPARSER
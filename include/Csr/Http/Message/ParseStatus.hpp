@@ -0,0 +1,23 @@
+#ifndef CSR_HTTP_MESSAGE_PARSESTATUS
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Codes to indicate the status of an incremental parser.
+ */
+enum ParseStatus {
+    /** All given bytes were consumed and more are needed to complete. */
+    PARSE_NEED_MORE = 0,
+
+    /** The message is complete; unconsumed bytes belong to the next one. */
+    PARSE_DONE = 1,
+
+    /** The input is malformed or exceeds a configured limit. */
+    PARSE_ERROR = 2
+};
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_PARSESTATUS
+#endif // CSR_HTTP_MESSAGE_PARSESTATUS
@@ -0,0 +1,99 @@
+#ifndef CSR_HTTP_MESSAGE_POOL
+
+#include "Allocator.hpp"
+
+#include <stddef.h>
+
+/**
+ * Default number of idle instances retained by a pool. May be overridden at
+ * compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_POOL_CAPACITY
+#define CSR_HTTP_MESSAGE_POOL_CAPACITY 64
+#endif
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Pool of reusable instances.
+ *
+ * Released instances keep their allocated storage, so that handling a
+ * request with an acquired and reset instance does not allocate once the
+ * pool is warm:
+ *
+ *     Pool<ServerRequest>* pool = Pool<ServerRequest>::getThreadPool();
+ *     ServerRequest* request = pool->acquire();
+ *     request->reset(method, uri, serverParams);
+ *     // ...
+ *     pool->release(request);
+ *
+ * Pooled instances keep their storage across requests, so they MUST be
+ * constructed with an allocator that outlives the pool, such as the default
+ * allocator. A per-request Arena MUST NOT be used, as it cannot be reset while
+ * pooled instances hold storage from it.
+ *
+ * Implementations MUST explicitly instantiate this template for Request,
+ * Response, ServerRequest and Uri. A pool is not thread-safe; each thread
+ * SHOULD use its own, as returned by getThreadPool().
+ */
+template <class T>
+class Pool {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Create a new pool.
+     *
+     * @param capacity Maximum number of idle instances to retain.
+     * @param allocator The allocator with which instances are constructed,
+     *     or NULL to use the default allocator; MUST outlive the pool.
+     */
+    explicit Pool(
+        size_t capacity = CSR_HTTP_MESSAGE_POOL_CAPACITY,
+        Allocator* allocator = NULL);
+
+    /**
+     * Retrieve the pool of the calling thread.
+     *
+     * The pool MUST be created on first use and destroyed when the thread
+     * exits.
+     *
+     * @return The pool of the calling thread.
+     */
+    static Pool* getThreadPool();
+
+    /**
+     * Acquire an instance from the pool.
+     *
+     * If the pool is empty, a new instance MUST be constructed with the
+     * allocator of the pool. The state of the instance is unspecified; the
+     * caller MUST call its reset() method before use.
+     *
+     * @return An instance owned by the caller until released.
+     */
+    T* acquire();
+
+    /**
+     * Return an instance to the pool.
+     *
+     * If the pool is full, the instance MUST be destroyed instead.
+     *
+     * @param object An instance acquired from this pool.
+     */
+    void release(T* object);
+
+    /**
+     * Retrieve the number of idle instances in the pool.
+     *
+     * @return The number of idle instances.
+     */
+    size_t getSize();
+
+    ~Pool();
+};
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_POOL
+#endif // CSR_HTTP_MESSAGE_POOL
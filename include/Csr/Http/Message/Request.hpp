@@ -7,6 +7,27 @@ namespace Csr {
 namespace Http {
 namespace Message {
 
+/**
+ * Identifiers for standard HTTP methods.
+ *
+ * @see http://tools.ietf.org/html/rfc7231#section-4.3
+ * @see http://tools.ietf.org/html/rfc5789
+ */
+enum MethodId {
+    /** The method is an extension method. */
+    METHOD_EXTENSION = 0,
+
+    METHOD_GET,
+    METHOD_HEAD,
+    METHOD_POST,
+    METHOD_PUT,
+    METHOD_DELETE,
+    METHOD_CONNECT,
+    METHOD_OPTIONS,
+    METHOD_TRACE,
+    METHOD_PATCH
+};
+
 /**
  * Representation of an outgoing, client-side request.
  *
@@ -50,6 +71,19 @@ class Request : public Message {
      */
     Request(const char* method, Uri* uri);
 
+    /**
+     * Create a new request using the given allocator.
+     *
+     * The URI created from `uri` MUST be constructed with the same allocator.
+     *
+     * @see Request(const char*, const char*)
+     * @param method The HTTP method associated with the request.
+     * @param uri The URI string associated with the request.
+     * @param allocator The allocator to use; MUST outlive the request.
+     * @throws std::invalid_argument Invalid HTTP method.
+     */
+    Request(const char* method, const char* uri, Allocator* allocator);
+
     /**
      * Retrieves the message's request-target.
      *
@@ -64,6 +98,10 @@ class Request : public Message {
      * If no URI is available, and no request-target has been specifically
      * provided, this method MUST return the string "/".
      *
+     * The request-target composed from the URI MUST be cached and reused
+     * until setRequestTarget() or setUri() is called, or the revision of the
+     * URI (see Uri::getRevision()) changes.
+     *
      * @return Message's request-target.
      */
     const char* getRequestTarget();
@@ -101,6 +139,45 @@ class Request : public Message {
      */
     void setMethod(const char* method);
 
+    /**
+     * Retrieves the HTTP method of the request as an identifier.
+     *
+     * Implementations SHOULD store the identifier, and only store the method
+     * string of extension methods, so that this method needs no string
+     * comparison and getMethod() returns a static string for standard
+     * methods.
+     *
+     *     switch (request->getMethodId()) {
+     *         case METHOD_GET:
+     *         case METHOD_HEAD:
+     *             // ...
+     *     }
+     *
+     * @return The request method identifier, or METHOD_EXTENSION if the
+     *     method is not a standard method.
+     */
+    MethodId getMethodId();
+
+    /**
+     * Change the provided HTTP method to a standard method.
+     *
+     * @param method The method identifier.
+     * @throws std::invalid_argument The identifier is METHOD_EXTENSION or
+     *     invalid.
+     */
+    void setMethod(MethodId method);
+
+    /**
+     * Change the provided HTTP method to a standard method given at compile
+     * time.
+     *
+     *     request->setMethod<METHOD_POST>();
+     *
+     * @see setMethod(MethodId)
+     */
+    template <MethodId M>
+    void setMethod() { setMethod(M); }
+
     /**
      * Retrieves the URI instance.
      *
@@ -136,7 +213,110 @@ class Request : public Message {
      */
     void setUri(Uri* uri, bool preserveHost = false);
 
-    ~Request();
+    /**
+     * Return an instance with the specified HTTP protocol version.
+     *
+     * @see Message::withProtocolVersion()
+     * @param version HTTP protocol version.
+     * @return A new request owned by the caller.
+     */
+    virtual Request* withProtocolVersion(const char* version);
+
+    /**
+     * Return an instance with the provided value replacing the specified
+     * header.
+     *
+     * @see Message::withHeader()
+     * @param name Case-insensitive header field name.
+     * @param value Header value.
+     * @return A new request owned by the caller.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    virtual Request* withHeader(const char* name, const char* value);
+
+    /**
+     * Return an instance with the specified header appended with the given
+     * value.
+     *
+     * @see Message::withAddedHeader()
+     * @param name Case-insensitive header field name to add.
+     * @param value Header value.
+     * @return A new request owned by the caller.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    virtual Request* withAddedHeader(const char* name, const char* value);
+
+    /**
+     * Return an instance without the specified header.
+     *
+     * @see Message::withoutHeader()
+     * @param name Case-insensitive header field name to remove.
+     * @return A new request owned by the caller.
+     */
+    virtual Request* withoutHeader(const char* name);
+
+    /**
+     * Return an instance with the specified message body.
+     *
+     * @see Message::withBody()
+     * @param body The body stream.
+     * @return A new request owned by the caller.
+     * @throws std::runtime_error The body is not valid.
+     */
+    virtual Request* withBody(Stream* body);
+
+    /**
+     * Return an instance with the specific request-target.
+     *
+     * @see setRequestTarget()
+     * @param requestTarget The request-target.
+     * @return A new request owned by the caller.
+     */
+    virtual Request* withRequestTarget(const char* requestTarget);
+
+    /**
+     * Return an instance with the provided HTTP method.
+     *
+     * @see setMethod()
+     * @param method Case-sensitive method.
+     * @return A new request owned by the caller.
+     * @throws std::invalid_argument Invalid HTTP method.
+     */
+    virtual Request* withMethod(const char* method);
+
+    /**
+     * Return an instance with the provided URI.
+     *
+     * The Host header MUST be updated as described in setUri(). The new
+     * request does not take ownership of `uri`.
+     *
+     * @see setUri()
+     * @param uri New request URI to use.
+     * @param preserveHost Preserve the original state of the Host header.
+     * @return A new request owned by the caller.
+     */
+    virtual Request* withUri(Uri* uri, bool preserveHost = false);
+
+    /**
+     * Returns the request to the state of a newly created request.
+     *
+     * The request MUST be left as if it had just been constructed with the
+     * given arguments, but allocated storage, including that of its URI,
+     * SHOULD be retained for reuse.
+     *
+     * Only a URI the request created itself MAY be reset with Uri::reset()
+     * and reused. A URI supplied by the caller, through
+     * Request(const char*, Uri*), setUri() or withUri(), is not owned by the
+     * request and MUST NOT be modified; a new URI MUST be created instead.
+     *
+     * @see Message::reset()
+     * @param method The HTTP method associated with the request.
+     * @param uri The URI string associated with the request.
+     * @throws std::invalid_argument Invalid HTTP method.
+     */
+    void reset(const char* method, const char* uri);
+
+    virtual ~Request();
 };
 
 }}} // Csr::Http::Message
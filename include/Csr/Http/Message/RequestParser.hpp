@@ -0,0 +1,215 @@
+#ifndef CSR_HTTP_MESSAGE_REQUESTPARSER
+
+#include "MultipartParser.hpp"
+#include "ParseStatus.hpp"
+#include "ServerRequest.hpp"
+
+/**
+ * Default maximum size in bytes of a request line and header section. May be
+ * overridden at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_MAX_HEADER_SIZE
+#define CSR_HTTP_MESSAGE_MAX_HEADER_SIZE 65536
+#endif
+
+/**
+ * Default maximum size in bytes of a request body. May be overridden at
+ * compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_MAX_BODY_SIZE
+#define CSR_HTTP_MESSAGE_MAX_BODY_SIZE 1073741824UL
+#endif
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Incremental HTTP/1.1 request parser.
+ *
+ * Bytes are pushed into the parser as they arrive, in chunks of any size.
+ * The parser keeps its state between calls, MUST NOT re-scan bytes it has
+ * already consumed, and builds a ServerRequest directly:
+ *
+ * - The method and request-target are used to construct the request, and
+ *   the request-target is also set verbatim with setRequestTarget().
+ * - The HTTP version is set with setProtocolVersion().
+ * - Each header field is added with setAddedHeader(), preserving order and
+ *   case.
+ * - The message body, framed by Content-Length or a chunked
+ *   Transfer-Encoding, is written to getBody() as it arrives. Chunked framing
+ *   MUST be removed from the stored body.
+ * - If an upload handler is set (see setUploadHandler()), a
+ *   multipart/form-data body of a POST request is instead fed to a
+ *   MultipartParser as it arrives, and its parts attached to the request.
+ *
+ * Line and header boundaries SHOULD be found, and header fields validated,
+ * with the functions of HeaderScanner.hpp.
+ *
+ * Pipelined requests are handled by parsing a chunk until PARSE_DONE is
+ * returned, releasing the request, and parsing the rest of the chunk from
+ * getOffset() onwards:
+ *
+ *     RequestParser parser;
+ *     size_t start = 0;
+ *     while (start < length) {
+ *         ParseStatus status = parser.parse(data + start, length - start);
+ *         if (status == PARSE_NEED_MORE) {
+ *             break;
+ *         }
+ *         if (status == PARSE_ERROR) {
+ *             respond(parser.getErrorStatus());
+ *             close(fd);
+ *             break;
+ *         }
+ *         start += parser.getOffset();
+ *         handle(parser.release());
+ *     }
+ *
+ * @see http://tools.ietf.org/html/rfc7230#section-3
+ */
+class RequestParser {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Create a new request parser.
+     *
+     * @param serverParams An array of Server API (SAPI) parameters with
+     *     which to seed every request built by the parser, or NULL.
+     * @param allocator The allocator with which to construct requests, or
+     *     NULL to use the default allocator.
+     * @param maxHeaderSize Maximum size in bytes of the request line and
+     *     header section.
+     * @param maxBodySize Maximum size in bytes of the decoded request body.
+     *     A Content-Length above this limit MUST be rejected as soon as the
+     *     header is parsed, and a chunked body as soon as it exceeds it.
+     */
+    explicit RequestParser(
+        char** serverParams = NULL,
+        Allocator* allocator = NULL,
+        size_t maxHeaderSize = CSR_HTTP_MESSAGE_MAX_HEADER_SIZE,
+        unsigned long maxBodySize = CSR_HTTP_MESSAGE_MAX_BODY_SIZE);
+
+    /**
+     * Enables streaming of multipart/form-data bodies.
+     *
+     * For each POST request with a multipart/form-data Content-Type, the body
+     * MUST be passed to a MultipartParser as it arrives, constructed with the
+     * boundary of the Content-Type, the given handler and limits and the
+     * allocator of the parser, and attached to the request with
+     * MultipartParser::attachTo(). Such a body MUST NOT be written to
+     * getBody(), so each upload is written only once, to the stream given by
+     * the handler. A malformed multipart body MUST result in PARSE_ERROR, as
+     * MUST exceeding a form field limit, with a status code of 413.
+     *
+     * This method affects requests whose header section has not yet been
+     * parsed.
+     *
+     * @param handler The provider of destination streams, or NULL to write
+     *     each file to a default stream, as created by Stream().
+     * @param maxFileSize Maximum size of each uploaded file in bytes, or -1
+     *     for no limit.
+     * @param maxFieldSize Maximum size in bytes of each form field value.
+     * @param maxFieldsSize Maximum combined size in bytes of all form field
+     *     names and values.
+     */
+    void setUploadHandler(
+        UploadHandler* handler,
+        long maxFileSize = -1,
+        size_t maxFieldSize = CSR_HTTP_MESSAGE_MAX_FORM_FIELD_SIZE,
+        size_t maxFieldsSize = CSR_HTTP_MESSAGE_MAX_FORM_FIELDS_SIZE);
+
+    /**
+     * Parse a chunk of bytes.
+     *
+     * The bytes need not be null-terminated and only need to remain valid for
+     * the duration of the call.
+     *
+     * Calling this method after PARSE_DONE without calling release() or
+     * reset() first, or after PARSE_ERROR without calling reset() first, MUST
+     * return PARSE_ERROR without consuming any bytes.
+     *
+     * @param data The bytes to parse.
+     * @param length The number of bytes in `data`.
+     * @return PARSE_NEED_MORE if every byte was consumed and the request is not
+     *     yet complete, PARSE_DONE if the request is complete, or PARSE_ERROR
+     *     if the input is malformed or exceeds a limit.
+     * @throws std::runtime_error The request body could not be written.
+     */
+    ParseStatus parse(const char* data, size_t length);
+
+    /**
+     * Retrieve the offset reached within the last chunk given to parse().
+     *
+     * After PARSE_NEED_MORE, this is the length of the chunk. After
+     * PARSE_DONE, this is the number of bytes that belong to the completed
+     * request; any remaining bytes belong to the next request. After
+     * PARSE_ERROR, this is the offset of the byte at which the error was
+     * detected.
+     *
+     * @return Offset in bytes within the last chunk.
+     */
+    size_t getOffset();
+
+    /**
+     * Retrieve the number of bytes consumed for the current request across
+     * every chunk given to parse().
+     *
+     * @return Offset in bytes within the current request.
+     */
+    unsigned long getPosition();
+
+    /**
+     * Checks whether the request line and header section are complete.
+     *
+     * Once true, getRequest() MUST return the request with its method,
+     * request-target, protocol version and headers set; its body may still be
+     * incomplete.
+     *
+     * @return True if the header section has been parsed, false if not.
+     */
+    bool hasHeaders();
+
+    /**
+     * Retrieve the request being built.
+     *
+     * The parser retains ownership of the request.
+     *
+     * @return The request, or NULL if the request line has not been parsed.
+     */
+    ServerRequest* getRequest();
+
+    /**
+     * Retrieve the response status code appropriate to the last error.
+     *
+     * For example: 400 for malformed syntax, 413 for an oversized body, 431
+     * for an oversized header section, 501 for an unsupported
+     * Transfer-Encoding and 505 for an unsupported HTTP version.
+     *
+     * @return Status code, or 0 if parse() has not returned PARSE_ERROR.
+     */
+    unsigned short getErrorStatus();
+
+    /**
+     * Release the completed request and prepare for the next one.
+     *
+     * Ownership of the request is transferred to the caller.
+     *
+     * @return The completed request.
+     * @throws std::runtime_error parse() has not returned PARSE_DONE.
+     */
+    ServerRequest* release();
+
+    /**
+     * Discard the current request and any error, and prepare for the next
+     * one.
+     */
+    void reset();
+
+    ~RequestParser();
+};
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_REQUESTPARSER
+#endif // CSR_HTTP_MESSAGE_REQUESTPARSER
@@ -1,6 +1,7 @@
 #ifndef CSR_HTTP_MESSAGE_RESPONSE
 
 #include "Message.hpp"
+#include "StatusLine.hpp"
 
 namespace Csr {
 namespace Http {
@@ -31,6 +32,19 @@ class Response : public Message {
      */
     Response(unsigned short code = 200, const char* reasonPhrase = "");
 
+    /**
+     * Create a new response using the given allocator.
+     *
+     * @see Response(unsigned short, const char*)
+     * @param code The HTTP status code.
+     * @param reasonPhrase The reason phrase to associate with the status code.
+     * @param allocator The allocator to use; MUST outlive the response.
+     */
+    Response(
+        unsigned short code,
+        const char* reasonPhrase,
+        Allocator* allocator);
+
     /**
      * Gets the response status code.
      *
@@ -48,6 +62,10 @@ class Response : public Message {
      * to the RFC 7231 or IANA recommended reason phrase for the response's
      * status code.
      *
+     * Implementations SHOULD reference the entry returned by findStatusLine()
+     * rather than copying the reason phrase, and SHOULD only copy
+     * `reasonPhrase` when it is non-empty and differs from that entry.
+     *
      * @see http://tools.ietf.org/html/rfc7231#section-6
      * @see http://www.iana.org/assignments/http-status-codes/http-status-codes.xhtml
      * @param code The 3-digit integer result code to set.
@@ -73,7 +91,105 @@ class Response : public Message {
      */
     const char* getReasonPhrase();
 
-    ~Response();
+    /**
+     * Gets the rendered status line of the response.
+     *
+     * The status line includes the protocol version, status code, reason
+     * phrase and the trailing CRLF, e.g., "HTTP/1.1 200 OK\r\n".
+     *
+     * If the protocol version is "1.0" or "1.1" and the reason phrase is the
+     * default for the status code, this method MUST return the pre-rendered
+     * line from findStatusLine() without allocating. Otherwise, the line
+     * SHOULD be rendered once and reused until the status or protocol version
+     * changes.
+     *
+     * @see http://tools.ietf.org/html/rfc7230#section-3.1.2
+     * @param length Receives the length of the status line in bytes, if not
+     *     NULL.
+     * @return The status line.
+     */
+    const char* getStatusLine(size_t* length = NULL);
+
+    /**
+     * Return an instance with the specified HTTP protocol version.
+     *
+     * @see Message::withProtocolVersion()
+     * @param version HTTP protocol version.
+     * @return A new response owned by the caller.
+     */
+    virtual Response* withProtocolVersion(const char* version);
+
+    /**
+     * Return an instance with the provided value replacing the specified
+     * header.
+     *
+     * @see Message::withHeader()
+     * @param name Case-insensitive header field name.
+     * @param value Header value.
+     * @return A new response owned by the caller.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    virtual Response* withHeader(const char* name, const char* value);
+
+    /**
+     * Return an instance with the specified header appended with the given
+     * value.
+     *
+     * @see Message::withAddedHeader()
+     * @param name Case-insensitive header field name to add.
+     * @param value Header value.
+     * @return A new response owned by the caller.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    virtual Response* withAddedHeader(const char* name, const char* value);
+
+    /**
+     * Return an instance without the specified header.
+     *
+     * @see Message::withoutHeader()
+     * @param name Case-insensitive header field name to remove.
+     * @return A new response owned by the caller.
+     */
+    virtual Response* withoutHeader(const char* name);
+
+    /**
+     * Return an instance with the specified message body.
+     *
+     * @see Message::withBody()
+     * @param body The body stream.
+     * @return A new response owned by the caller.
+     * @throws std::runtime_error The body is not valid.
+     */
+    virtual Response* withBody(Stream* body);
+
+    /**
+     * Return an instance with the specified status code and, optionally,
+     * reason phrase.
+     *
+     * @see setStatus()
+     * @param code The 3-digit integer result code to set.
+     * @param reasonPhrase The reason phrase to use with the provided status
+     *     code.
+     * @return A new response owned by the caller.
+     * @throws std::invalid_argument Invalid status code arguments.
+     */
+    virtual Response* withStatus(
+        unsigned short code,
+        const char* reasonPhrase = "");
+
+    /**
+     * Returns the response to the state of a newly created response.
+     *
+     * The response MUST be left as if it had just been constructed with the
+     * given arguments, but allocated storage SHOULD be retained for reuse.
+     *
+     * @see Message::reset()
+     * @param code The HTTP status code. Defaults to 200.
+     * @param reasonPhrase The reason phrase to associate with the status code.
+     */
+    void reset(unsigned short code = 200, const char* reasonPhrase = "");
+
+    virtual ~Response();
 };
 
 }}} // Csr::Http::Message
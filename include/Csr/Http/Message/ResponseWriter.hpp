@@ -0,0 +1,157 @@
+#ifndef CSR_HTTP_MESSAGE_RESPONSEWRITER
+
+#include "Response.hpp"
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * A contiguous region of bytes to be written.
+ *
+ * Implementations convert segments to `struct iovec` or `WSABUF` as the
+ * platform requires.
+ */
+struct WriteSegment {
+    /** Pointer to the first byte of the region. */
+    const char* data;
+
+    /** The number of bytes in the region. */
+    size_t length;
+};
+
+/**
+ * Serializes a response to the wire without an intermediate buffer.
+ *
+ * The writer builds a list of segments referring directly to the status line
+ * (see Response::getStatusLine()), every header name and value, their
+ * delimiters, and the body, and emits them with scatter/gather I/O (e.g., a
+ * single `writev()` or `sendmsg()` call, or `WSASend()` on Windows). Bodies
+ * backed by memory are included in the same call; file-backed bodies are sent
+ * afterwards with Stream::transferTo().
+ *
+ * A filtered body (see Stream::getFilter()) reports the backend of the
+ * stream it wraps, but its bytes are only available through Stream::read().
+ * The writer MUST check the filter before the backend, and never reference
+ * the memory of a filtered body or send it with Stream::transferTo().
+ *
+ *     ResponseWriter writer(response);
+ *     while (!writer.isComplete()) {
+ *         if (writer.writeTo(fd) == 0) {
+ *             waitUntilWritable(fd);
+ *         }
+ *     }
+ *
+ * If the response has neither a Content-Length nor a Transfer-Encoding
+ * header, the writer MUST send a Content-Length header with the size of the
+ * body if it is known (see Stream::getSize()), or 0 if Message::hasBody()
+ * returns false, without modifying the response. No Content-Length header
+ * is sent for responses with a 1xx or 204 status code.
+ *
+ * A body of unknown size (see Stream::getSize()) is framed according to the
+ * headers of the response. If the last coding of its Transfer-Encoding header
+ * is "chunked", the writer MUST encode the body with the chunked transfer
+ * coding, including the last chunk. Otherwise, the body is written until its
+ * end and the connection MUST be closed afterwards to delimit it.
+ *
+ * A body that is not readable, such as a stream applying
+ * STREAM_FILTER_CHUNKED_ENCODE, cannot be written and MUST be rejected.
+ *
+ * The response, its headers and its body MUST NOT be modified until the
+ * writer is complete or destroyed.
+ */
+class ResponseWriter {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Create a new writer for the given response.
+     *
+     * @param response The response to serialize. The writer does not take
+     *     ownership of it.
+     * @param includeBody Whether the body is to be written; pass false for
+     *     responses to HEAD requests.
+     * @throws std::runtime_error The body is to be written but is not
+     *     readable.
+     */
+    explicit ResponseWriter(Response* response, bool includeBody = true);
+
+    /**
+     * Write as much of the response as possible to a descriptor.
+     *
+     * Every pending segment MUST be written with one scatter/gather call
+     * where the platform allows it. After a short write, the next call MUST
+     * resume at the first unwritten byte.
+     *
+     * If `fd` is non-blocking, this method MUST return as soon as the
+     * descriptor would block.
+     *
+     * @param fd The destination file or socket descriptor.
+     * @return The number of bytes written by this call, or 0 if `fd` would
+     *     block or the writer is complete.
+     * @throws std::runtime_error The descriptor could not be written or the
+     *     body could not be read.
+     */
+    long writeTo(int fd);
+
+    /**
+     * Retrieve the pending in-memory segments.
+     *
+     * This allows the response to be written with I/O facilities other than
+     * writeTo(), e.g., an io_uring submission. The segments begin at the
+     * first unwritten byte. A file-backed body is not included; once every
+     * segment has been written, it is available through getBody(). A
+     * filtered body is read into a buffer of the writer as the preceding
+     * segments are written, and returned as further segments.
+     *
+     * @param segments Array to receive the segments.
+     * @param count The capacity of `segments`.
+     * @return The number of segments stored in `segments`.
+     */
+    size_t getSegments(WriteSegment* segments, size_t count);
+
+    /**
+     * Marks bytes as written by the caller.
+     *
+     * @param length The number of bytes written from the segments returned by
+     *     getSegments() or the body returned by getBody().
+     * @throws std::invalid_argument More bytes than are pending.
+     */
+    void advance(size_t length);
+
+    /**
+     * Retrieve the body to be sent after the pending segments.
+     *
+     * @return The body stream if it is file-backed, unfiltered and not yet
+     *     written, or NULL.
+     */
+    Stream* getBody();
+
+    /**
+     * Retrieve the number of bytes written so far.
+     *
+     * @return The number of bytes written by writeTo() or marked by advance().
+     */
+    unsigned long getWritten();
+
+    /**
+     * Checks whether the whole response has been written.
+     *
+     * @return True if every byte has been written, false if not.
+     */
+    bool isComplete();
+
+    /**
+     * Checks whether the connection must be closed after the response.
+     *
+     * @return True if the body is delimited by closing the connection, or
+     *     the response has a Connection header of "close", false if not.
+     */
+    bool requiresClose();
+
+    ~ResponseWriter();
+};
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_RESPONSEWRITER
+#endif // CSR_HTTP_MESSAGE_RESPONSEWRITER
@@ -3,10 +3,74 @@
 #include "Request.hpp"
 #include "UploadedFile.hpp"
 
+/**
+ * Default maximum length in bytes of a body parameter name. May be overridden
+ * at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_MAX_BODY_PARAM_NAME
+#define CSR_HTTP_MESSAGE_MAX_BODY_PARAM_NAME 1024
+#endif
+
+/**
+ * Default maximum size in bytes of a form-encoded request body. May be
+ * overridden at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_MAX_BODY_PARAMS_SIZE
+#define CSR_HTTP_MESSAGE_MAX_BODY_PARAMS_SIZE 8388608
+#endif
+
+/**
+ * Default slot count of a concurrent attribute store. May be overridden at
+ * compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_ATTRIBUTE_CAPACITY
+#define CSR_HTTP_MESSAGE_ATTRIBUTE_CAPACITY 32
+#endif
+
 namespace Csr {
 namespace Http {
 namespace Message {
 
+/**
+ * Iterates over a list of request parameters.
+ *
+ * Iterating MUST NOT allocate memory. Names and values SHOULD only be
+ * decoded when they are retrieved.
+ */
+class ParamIterator {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Moves cursor to next parameter in the list.
+     *
+     * This method MUST be called at least once before parameters
+     * can be retrieved.
+     *
+     * @return True if there was a next parameter to move to, false if not.
+     */
+    bool next();
+
+    /**
+     * Moves cursor back to the beginning of the list.
+     */
+    void reset();
+
+    /**
+     * Gets the decoded name of the current parameter.
+     *
+     * @return Name of the current parameter.
+     */
+    const char* getName();
+
+    /**
+     * Gets the decoded value of the current parameter.
+     *
+     * @return Value of the current parameter.
+     */
+    const char* getValue();
+};
+
 /**
  * Representation of an incoming, server-side HTTP request.
  *
@@ -33,6 +97,11 @@ namespace Message {
  * matching, decrypting cookie values, deserializing non-form-encoded body
  * content, matching authorization headers to users, etc). These parameters
  * are stored in an "attributes" property.
+ *
+ * The with*() methods are re-declared to return server requests. Copies
+ * MUST carry over the server parameters, attributes, cookie, query and body
+ * parameters and uploaded files of the original, shared as described for
+ * Message.
  */
 class ServerRequest : public Request {
     // Add private members here per implementation.
@@ -52,6 +121,27 @@ class ServerRequest : public Request {
      */
     ServerRequest(const char* method, const char* uri, char** serverParams);
 
+    /**
+     * Create a new server request using the given allocator.
+     *
+     * The URI, headers, server, cookie, query and body parameters,
+     * attributes and uploaded files owned by the request MUST all be
+     * allocated through `allocator`, so that an Arena can release them in one
+     * shot when the request ends.
+     *
+     * @see ServerRequest(const char*, const char*, char**)
+     * @param method The HTTP method associated with the request.
+     * @param uri The URI associated with the request.
+     * @param serverParams An array of Server API (SAPI) parameters with
+     *     which to seed the generated request instance.
+     * @param allocator The allocator to use; MUST outlive the request.
+     */
+    ServerRequest(
+        const char* method,
+        const char* uri,
+        char** serverParams,
+        Allocator* allocator);
+
     /**
      * Retrieve server parameter.
      *
@@ -71,11 +161,32 @@ class ServerRequest : public Request {
      *
      * Retrieves cookies sent by the client to the server.
      *
+     * The Cookie header SHOULD be parsed once, on the first call to this
+     * method or getCookieParams(), into an index of name and value slices
+     * over a private copy of the header bytes, made with a single
+     * allocation. Quoted values SHOULD only be unquoted, in place within that
+     * copy, when they are first retrieved. The stored Cookie header MUST NOT
+     * be modified, so that getHeader(), getHeaderLine() and getHeaders(), and
+     * messages sharing the header storage, are unaffected.
+     *
+     * @see http://tools.ietf.org/html/rfc6265#section-5.4
      * @return The value of the cookie or a null-terminated string if it cannot
      *     be found.
      */
     const char* getCookieParam(const char* name);
 
+    /**
+     * Retrieve all cookies.
+     *
+     * Cookies MUST be iterated in the order in which they appear in the
+     * Cookie header.
+     *
+     * @see getCookieParam()
+     * @return Iterator for all cookies. If there are none, this method MUST
+     *     return an empty iterator.
+     */
+    ParamIterator getCookieParams();
+
     /**
      * Retrieve query string arguments.
      *
@@ -86,11 +197,29 @@ class ServerRequest : public Request {
      * values, you may need to parse the query string from
      * `getUri()->getQuery()` or from the `QUERY_STRING` server param.
      *
+     * The query string SHOULD be parsed once, on the first call to this
+     * method or getQueryParams(), into an index of offsets within a single
+     * buffer, with a hash table of names so that each lookup takes constant
+     * time. Values SHOULD only be percent-decoded when they are first
+     * retrieved.
+     *
      * @return The value of the query parameter or a null-terminated string if
      *     none can be found.
      */
     const char* getQueryParam(const char* name);
 
+    /**
+     * Retrieve all query string arguments.
+     *
+     * Parameters MUST be iterated in the order in which they appear in the
+     * query string.
+     *
+     * @see getQueryParam()
+     * @return Iterator for all query parameters. If there are none, this
+     *     method MUST return an empty iterator.
+     */
+    ParamIterator getQueryParams();
+
     /**
      * Retrieve file upload data.
      *
@@ -101,10 +230,30 @@ class ServerRequest : public Request {
      * when the request Content-Type is multipart/form-data, and the request
      * method is POST.
      *
+     * Implementations SHOULD parse the body with a MultipartParser as it
+     * arrives, rather than once it has been stored in full, e.g., using
+     * RequestParser::setUploadHandler(). Files parsed this way are attached
+     * with setUploadedFile(), and the body is then never stored as a whole.
+     *
      * @return An uploaded file instance or null if none can be found.
      */
     UploadedFile* getUploadedFile(const char* name);
 
+    /**
+     * Attaches an uploaded file to the request.
+     *
+     * The request takes ownership of `file`, replacing and destroying any
+     * uploaded file previously attached with the same name. Once any file or
+     * body parameter has been attached, this method and setBodyParam() are
+     * the only sources of uploaded files and body parameters, and the body
+     * MUST NOT be parsed for them.
+     *
+     * @see getUploadedFile()
+     * @param name The form field name.
+     * @param file The uploaded file.
+     */
+    void setUploadedFile(const char* name, UploadedFile* file);
+
     /**
      * Retrieve a parameter provided in the request body.
      *
@@ -113,15 +262,72 @@ class ServerRequest : public Request {
      * Request body parameters are ONLY parsed and made available by this method
      * when the request Content-Type is either application/x-www-form-urlencoded
      * or multipart/form-data, and the request method is POST.
+     *
+     * An application/x-www-form-urlencoded body SHOULD be parsed once, on
+     * the first call to this method or getBodyParams(), by reading the body
+     * stream in fixed-size chunks into the same kind of index as query
+     * parameters (see getQueryParam()). The limits set by
+     * setBodyParamLimits() MUST be enforced while reading, so that an
+     * oversized body is rejected before it is read in full. Values SHOULD
+     * only be percent-decoded when they are first retrieved.
+     *
+     * If the body is seekable, it MUST be read from its beginning, calling
+     * Stream::rewind() first, as RequestParser leaves it at its end, and its
+     * position MUST be restored once the index is built. A body that is not
+     * seekable MUST be read from its current position and is left at its
+     * end; its raw bytes are then no longer available, and later readers
+     * MUST rely on the index. Code that needs the raw bytes of such a body
+     * MUST read them before calling this method.
      * 
      * @return The value of the body parameter or a null-terminated string
      *     if none can be found. If the request Content-Type is NOT either
      *     application/x-www-form-urlencoded or multipart/form-data or the
      *     request method is NOT POST then this method returns a
      *     null-terminated string.
+     * @throws std::runtime_error The body exceeds the body parameter limits
+     *     or cannot be read.
      */
     const char* getBodyParam(const char* name);
 
+    /**
+     * Retrieve all parameters provided in the request body.
+     *
+     * Parameters MUST be iterated in the order in which they appear in the
+     * body.
+     *
+     * @see getBodyParam()
+     * @return Iterator for all body parameters. If there are none, or the
+     *     request is not eligible as described in getBodyParam(), this method
+     *     MUST return an empty iterator.
+     * @throws std::runtime_error The body exceeds the body parameter limits
+     *     or cannot be read.
+     */
+    ParamIterator getBodyParams();
+
+    /**
+     * Attaches a body parameter to the request.
+     *
+     * Parameters are appended in the order in which they are attached.
+     *
+     * @see setUploadedFile()
+     * @param name The parameter name.
+     * @param value The decoded parameter value.
+     */
+    void setBodyParam(const char* name, const char* value);
+
+    /**
+     * Changes the limits enforced when parsing body parameters.
+     *
+     * This method MUST be called before the body parameters are first
+     * accessed to have any effect.
+     *
+     * @param maxNameSize Maximum length in bytes of a parameter name.
+     * @param maxBodySize Maximum size in bytes of the form-encoded body.
+     */
+    void setBodyParamLimits(
+        size_t maxNameSize = CSR_HTTP_MESSAGE_MAX_BODY_PARAM_NAME,
+        size_t maxBodySize = CSR_HTTP_MESSAGE_MAX_BODY_PARAMS_SIZE);
+
     /**
      * Retrieve a single derived request attribute.
      *
@@ -157,6 +363,7 @@ class ServerRequest : public Request {
      * @see getAttribute()
      * @param name The attribute name.
      * @param value The value of the attribute.
+     * @throws std::runtime_error The concurrent attribute store is full.
      */
     void setAttribute(const char* name, const char* value);
 
@@ -171,7 +378,135 @@ class ServerRequest : public Request {
      */
     void removeAttribute(const char* name);
 
-    ~ServerRequest();
+    /**
+     * Switches the attributes to a thread-safe, lock-free store.
+     *
+     * Once enabled, getAttribute(), setAttribute() and removeAttribute() MAY
+     * be called concurrently from any thread. The store MUST be a
+     * fixed-capacity open-addressed table whose slots are published with
+     * atomic operations, so that getAttribute() is wait-free and no method
+     * takes a lock.
+     *
+     * Strings returned by getAttribute() MUST remain valid until the request
+     * is destroyed or reset, even if the attribute is replaced or removed
+     * by another thread in the meantime.
+     *
+     * This method MUST be called before the request is shared with other
+     * threads. Existing attributes MUST be carried over.
+     *
+     * @param capacity The number of slots in the store.
+     * @throws std::runtime_error The existing attributes exceed `capacity`.
+     */
+    void setConcurrentAttributes(
+        size_t capacity = CSR_HTTP_MESSAGE_ATTRIBUTE_CAPACITY);
+
+    /**
+     * Checks whether the attributes use a thread-safe store.
+     *
+     * @see setConcurrentAttributes()
+     * @return True if the concurrent store is enabled, false if not.
+     */
+    bool hasConcurrentAttributes();
+
+    /**
+     * Return an instance with the specified HTTP protocol version.
+     *
+     * @see Request::withProtocolVersion()
+     * @param version HTTP protocol version.
+     * @return A new server request owned by the caller.
+     */
+    virtual ServerRequest* withProtocolVersion(const char* version);
+
+    /**
+     * Return an instance with the provided value replacing the specified
+     * header.
+     *
+     * @see Request::withHeader()
+     * @param name Case-insensitive header field name.
+     * @param value Header value.
+     * @return A new server request owned by the caller.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    virtual ServerRequest* withHeader(const char* name, const char* value);
+
+    /**
+     * Return an instance with the specified header appended with the given
+     * value.
+     *
+     * @see Request::withAddedHeader()
+     * @param name Case-insensitive header field name to add.
+     * @param value Header value.
+     * @return A new server request owned by the caller.
+     * @throws std::runtime_error Invalid header names or values.
+     */
+    virtual ServerRequest* withAddedHeader(const char* name, const char* value);
+
+    /**
+     * Return an instance without the specified header.
+     *
+     * @see Request::withoutHeader()
+     * @param name Case-insensitive header field name to remove.
+     * @return A new server request owned by the caller.
+     */
+    virtual ServerRequest* withoutHeader(const char* name);
+
+    /**
+     * Return an instance with the specified message body.
+     *
+     * @see Request::withBody()
+     * @param body The body stream.
+     * @return A new server request owned by the caller.
+     * @throws std::runtime_error The body is not valid.
+     */
+    virtual ServerRequest* withBody(Stream* body);
+
+    /**
+     * Return an instance with the specific request-target.
+     *
+     * @see Request::withRequestTarget()
+     * @param requestTarget The request-target.
+     * @return A new server request owned by the caller.
+     */
+    virtual ServerRequest* withRequestTarget(const char* requestTarget);
+
+    /**
+     * Return an instance with the provided HTTP method.
+     *
+     * @see Request::withMethod()
+     * @param method Case-sensitive method.
+     * @return A new server request owned by the caller.
+     * @throws std::invalid_argument Invalid HTTP method.
+     */
+    virtual ServerRequest* withMethod(const char* method);
+
+    /**
+     * Return an instance with the provided URI.
+     *
+     * @see Request::withUri()
+     * @param uri New request URI to use.
+     * @param preserveHost Preserve the original state of the Host header.
+     * @return A new server request owned by the caller.
+     */
+    virtual ServerRequest* withUri(Uri* uri, bool preserveHost = false);
+
+    /**
+     * Returns the request to the state of a newly created request.
+     *
+     * The request MUST be left as if it had just been constructed with the
+     * given arguments, but allocated storage, including that of its URI,
+     * parameter indexes and attributes, SHOULD be retained for reuse. As for
+     * Request::reset(), a URI supplied by the caller MUST NOT be modified.
+     * Uploaded files that have not been moved MUST be removed.
+     *
+     * @see Request::reset()
+     * @param method The HTTP method associated with the request.
+     * @param uri The URI associated with the request.
+     * @param serverParams An array of Server API (SAPI) parameters with
+     *     which to seed the request instance.
+     */
+    void reset(const char* method, const char* uri, char** serverParams);
+
+    virtual ~ServerRequest();
 };
 
 }}} // Csr::Http::Message
@@ -0,0 +1,49 @@
+#ifndef CSR_HTTP_MESSAGE_STATUSLINE
+
+#include <stddef.h>
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Pre-rendered status line of a registered status code.
+ *
+ * For example, the entry for 404 holds "Not Found",
+ * "HTTP/1.0 404 Not Found\r\n" and "HTTP/1.1 404 Not Found\r\n".
+ *
+ * @see http://tools.ietf.org/html/rfc7230#section-3.1.2
+ */
+struct StatusLine {
+    /** The 3-digit status code. */
+    unsigned short code;
+
+    /** The recommended reason phrase. */
+    const char* reasonPhrase;
+
+    /** The complete HTTP/1.0 status line, including the trailing CRLF. */
+    const char* http10;
+
+    /** The complete HTTP/1.1 status line, including the trailing CRLF. */
+    const char* http11;
+
+    /** The length in bytes of either status line. */
+    size_t length;
+};
+
+/**
+ * Look up the pre-rendered status line of a status code.
+ *
+ * Implementations MUST back this function with a statically initialized
+ * table indexed by status code, covering every code in the IANA HTTP Status
+ * Code Registry, so that lookups take constant time and never allocate.
+ *
+ * @see http://www.iana.org/assignments/http-status-codes/http-status-codes.xhtml
+ * @param code The 3-digit status code.
+ * @return The table entry, or NULL if the code is not registered.
+ */
+const StatusLine* findStatusLine(unsigned short code);
+
+}}} // Csr::Http::Message
+#define CSR_HTTP_MESSAGE_STATUSLINE
+#endif // CSR_HTTP_MESSAGE_STATUSLINE
@@ -2,10 +2,130 @@
 
 #include <stdio.h>
 
+/**
+ * Default number of bytes an in-memory stream may hold before spilling to a
+ * temporary file. May be overridden at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_STREAM_SPILL_THRESHOLD
+#define CSR_HTTP_MESSAGE_STREAM_SPILL_THRESHOLD 1048576
+#endif
+
+/**
+ * Default number of submission queue entries of each per-thread io_uring
+ * instance. May be overridden at compile time.
+ */
+#ifndef CSR_HTTP_MESSAGE_URING_ENTRIES
+#define CSR_HTTP_MESSAGE_URING_ENTRIES 256
+#endif
+
 namespace Csr {
 namespace Http {
 namespace Message {
 
+class Message;
+class Stream;
+
+/**
+ * Resources that may back a stream.
+ */
+enum StreamBackend {
+    /** The stream wraps a FILE* using buffered stdio calls. */
+    STREAM_BACKEND_FILE = 0,
+
+    /**
+     * The stream is a read-only memory mapping of a file, e.g., using
+     * `mmap()` or `MapViewOfFile()`.
+     */
+    STREAM_BACKEND_MAPPED = 1,
+
+    /**
+     * The stream is a growable in-memory buffer that spills to a temporary
+     * file once it exceeds its spill threshold.
+     */
+    STREAM_BACKEND_MEMORY = 2,
+
+    /**
+     * The stream is a file accessed through an io_uring instance shared by
+     * every stream of the calling thread.
+     */
+    STREAM_BACKEND_URING = 3,
+
+    /** The number of stream backends. */
+    STREAM_BACKEND_COUNT
+};
+
+/**
+ * Transformations a stream may apply to another stream.
+ */
+enum StreamFilter {
+    /** The stream does not wrap another stream. */
+    STREAM_FILTER_NONE = 0,
+
+    /** Bytes read are decoded from the chunked transfer coding. */
+    STREAM_FILTER_CHUNKED_DECODE = 1,
+
+    /** Bytes written are encoded with the chunked transfer coding. */
+    STREAM_FILTER_CHUNKED_ENCODE = 2,
+
+    /** Bytes are compressed with the gzip coding. */
+    STREAM_FILTER_GZIP_ENCODE = 3,
+
+    /** Bytes are decompressed from the gzip coding. */
+    STREAM_FILTER_GZIP_DECODE = 4,
+
+    /** Bytes are compressed with the deflate coding. */
+    STREAM_FILTER_DEFLATE_ENCODE = 5,
+
+    /** Bytes are decompressed from the deflate coding. */
+    STREAM_FILTER_DEFLATE_DECODE = 6,
+
+    /** Bytes are compressed with the Brotli coding. */
+    STREAM_FILTER_BROTLI_ENCODE = 7,
+
+    /** Bytes are decompressed from the Brotli coding. */
+    STREAM_FILTER_BROTLI_DECODE = 8,
+
+    /** Bytes are compressed with the Zstandard coding. */
+    STREAM_FILTER_ZSTD_ENCODE = 9,
+
+    /** Bytes are decompressed from the Zstandard coding. */
+    STREAM_FILTER_ZSTD_DECODE = 10
+};
+
+/**
+ * Codes to indicate the result of a non-blocking stream operation.
+ */
+enum StreamStatus {
+    /** At least one byte was transferred. */
+    STREAM_OK = 0,
+
+    /** No byte could be transferred without blocking. */
+    STREAM_WOULD_BLOCK = 1,
+
+    /** The end of the stream has been reached. */
+    STREAM_END = 2
+};
+
+/**
+ * Readiness events of a stream, which may be combined.
+ */
+enum StreamEvent {
+    /** The stream may be read without blocking. */
+    STREAM_READABLE = 1,
+
+    /** The stream may be written without blocking. */
+    STREAM_WRITABLE = 2
+};
+
+/**
+ * Function called when a stream becomes ready.
+ *
+ * @param stream The stream that became ready.
+ * @param events The StreamEvent values that occurred, combined.
+ * @param context The context given when the callback was registered.
+ */
+typedef void (*StreamCallback)(Stream* stream, int events, void* context);
+
 /**
  * Describes a data stream.
  *
@@ -21,12 +141,43 @@ class Stream {
     /**
      * Creates a default stream.
      *
-     * The stream SHOULD be created with a temporary resource.
+     * The stream SHOULD be created with the `STREAM_BACKEND_MEMORY` backend
+     * and a spill threshold of `CSR_HTTP_MESSAGE_STREAM_SPILL_THRESHOLD`
+     * bytes, so that no temporary resource is created until it is needed.
      *
      * @throws std::runtime_error The temporary resource could not be created.
      */
     Stream();
 
+    /**
+     * Creates a temporary stream using the given backend.
+     *
+     * With `STREAM_BACKEND_FILE`, the stream MUST be created with a
+     * temporary resource, e.g., using `tmpfile()`.
+     *
+     * With `STREAM_BACKEND_URING`, the stream MUST be created with a
+     * temporary file, e.g., using `O_TMPFILE`, accessed as described in
+     * Stream(const char*, const char*, StreamBackend).
+     *
+     * With `STREAM_BACKEND_MEMORY`, the stream MUST be held in memory and
+     * MUST NOT acquire a file descriptor until its size exceeds
+     * `spillThreshold` bytes. Small contents SHOULD be stored inline, without
+     * a separate heap allocation. Once the threshold is exceeded, the
+     * contents MUST be moved to a temporary resource and the stream MUST
+     * behave as a `STREAM_BACKEND_FILE` stream from then on. A threshold of
+     * 0 disables spilling. detach() MUST return NULL if the stream has not
+     * spilled.
+     *
+     * @param backend The resource that will back the stream.
+     * @param spillThreshold Size in bytes after which an in-memory stream is
+     *     moved to a temporary resource.
+     * @throws std::runtime_error The temporary resource could not be created,
+     *     or the backend requires a filename.
+     */
+    explicit Stream(
+        StreamBackend backend,
+        size_t spillThreshold = CSR_HTTP_MESSAGE_STREAM_SPILL_THRESHOLD);
+
     /**
      * Create a stream from an existing file.
      *
@@ -42,6 +193,63 @@ class Stream {
      */
     Stream(const char* filename, const char* mode = "r");
 
+    /**
+     * Create a stream from an existing file using the given backend.
+     *
+     * With `STREAM_BACKEND_FILE`, this behaves identically to
+     * Stream(const char*, const char*).
+     *
+     * With `STREAM_BACKEND_MAPPED`, the file MUST be mapped into memory in its
+     * entirety and `mode` MUST be a read-only mode ("r" or "rb"). For a
+     * mapped stream:
+     *
+     * - toString(size_t*) and getContents(size_t*) MUST return pointers into
+     *   the mapping and MUST NOT allocate. toString() and getContents() MUST
+     *   still return null-terminated strings, which MAY require a copy; users
+     *   of mapped streams should prefer the length-returning overloads.
+     * - getSize() MUST complete in constant time.
+     * - seek(), tell() and rewind() MUST NOT perform any I/O.
+     * - isWritable() MUST return false, and detach() MUST return NULL.
+     * - The mapping MUST remain valid until the stream is closed or
+     *   destroyed.
+     *
+     * With `STREAM_BACKEND_URING`, reads and writes MUST be performed with
+     * an io_uring instance per thread, of `CSR_HTTP_MESSAGE_URING_ENTRIES`
+     * entries, shared by every stream used on that thread:
+     *
+     * - Each operation MUST be submitted to the ring of the calling thread,
+     *   and its completion MUST be reaped from that same ring. A stream MAY
+     *   be handed to another thread once no operation is pending, but MUST
+     *   NOT be used by several threads concurrently.
+     * - Buffers that writes copy into SHOULD be registered with the ring.
+     *   Reads MUST target the caller's buffer directly, as required by
+     *   read(char*, size_t), and MUST NOT use registered buffers.
+     * - Submissions of all streams of the thread SHOULD be batched, being
+     *   submitted no later than when an operation must wait for a
+     *   completion.
+     * - Writes MAY complete after write() returns, but write() MUST NOT
+     *   reference `data` once it returns: it MUST either copy the data into
+     *   a buffer of the ring, which counts as a copy the underlying
+     *   resource requires, or wait for the completion.
+     * - close() and detach() MUST wait until every pending write of the
+     *   stream has completed, and MUST throw if any of them failed.
+     *   Otherwise, a failed write MUST be reported by the next operation on
+     *   the stream.
+     * - The destructor MUST NOT throw; failures only known on destruction
+     *   are discarded, so callers SHOULD close() the stream explicitly.
+     * - Where io_uring is unavailable, `pread()` and `pwrite()` MUST be
+     *   performed by a thread pool instead; getBackend() still returns
+     *   `STREAM_BACKEND_URING`.
+     * - detach() MUST return NULL.
+     *
+     * @param filename The filename to use as basis of stream.
+     * @param mode The mode with which to open the underlying filename.
+     * @param backend The resource that will back the stream.
+     * @throws std::runtime_error The file cannot be opened or mapped, or mode
+     *     is invalid for the backend.
+     */
+    Stream(const char* filename, const char* mode, StreamBackend backend);
+
     /**
      * Create a new stream from an existing resource.
      *
@@ -51,6 +259,43 @@ class Stream {
      */
     Stream(FILE* resource);
 
+    /**
+     * Create a stream that transforms another stream.
+     *
+     * The new stream does not take ownership of `inner`, and bytes MUST be
+     * transformed as they pass through, without buffering the whole stream.
+     * A filtered stream is not seekable, and getSize() MUST return -1.
+     *
+     * With `STREAM_FILTER_CHUNKED_DECODE`, the stream is read-only: reads
+     * return the chunk data of `inner`, without its framing. When the last
+     * chunk is reached, the stream is at its end and any trailer fields MUST
+     * be added to `trailers` with Message::setAddedHeader().
+     *
+     * With `STREAM_FILTER_CHUNKED_ENCODE`, the stream is write-only: each
+     * non-empty write MUST be written to `inner` as one chunk using the
+     * length-aware write(const char*, size_t), so that a body can be sent
+     * before its size is known. close() MUST write the last chunk followed
+     * by every header of `trailers` as a trailer field, and MUST NOT close
+     * `inner`.
+     *
+     * With a compression filter, e.g., `STREAM_FILTER_GZIP_ENCODE`, the
+     * stream may be read, producing the transformed bytes of `inner`, or
+     * written, writing the transformed bytes to `inner`. Bytes MUST be
+     * transformed in bounded chunks. When written, close() MUST flush the
+     * codec and write the end of the compressed data, and MUST NOT close
+     * `inner`. `trailers` is ignored.
+     *
+     * @see http://tools.ietf.org/html/rfc7230#section-4.1
+     * @param inner The stream to transform; MUST outlive the new stream.
+     * @param filter The transformation to apply.
+     * @param trailers The message receiving decoded trailer fields, or
+     *     providing trailer fields to encode, or NULL for none.
+     * @throws std::runtime_error `inner` is not readable or writable as
+     *     required by the filter, or the filter is invalid or unsupported by
+     *     the implementation.
+     */
+    Stream(Stream* inner, StreamFilter filter, Message* trailers = NULL);
+
     /**
      * Reads all data from the stream into a string, from the beginning to end.
      *
@@ -65,8 +310,43 @@ class Stream {
      */
     const char* toString();
 
+    /**
+     * Reads all data from the stream, from the beginning to end, and its
+     * length.
+     *
+     * Unlike toString(), the returned data is not required to be
+     * null-terminated, and MAY contain embedded null bytes.
+     *
+     * This method MUST NOT raise an exception.
+     *
+     * @see toString()
+     * @param length Receives the length of the data in bytes.
+     * @return Stream data.
+     */
+    const char* toString(size_t* length);
+
+    /**
+     * Retrieve the resource backing the stream.
+     *
+     * For a filtered stream, this is the backend of the stream it wraps;
+     * its bytes MUST still be read through read(), not from the memory or
+     * descriptor of that backend. Check getFilter() first.
+     *
+     * @return The stream backend.
+     */
+    StreamBackend getBackend();
+
+    /**
+     * Retrieve the transformation applied by the stream.
+     *
+     * @return The stream filter, or STREAM_FILTER_NONE.
+     */
+    StreamFilter getFilter();
+
     /**
      * Closes the stream and any underlying resources.
+     *
+     * @throws std::runtime_error A pending write failed.
      */
     void close();
 
@@ -76,6 +356,7 @@ class Stream {
      * After the stream has been detached, the stream is in an unusable state.
      *
      * @return Underlying resource or NULL.
+     * @throws std::runtime_error A pending write failed.
      */
     FILE* detach();
 
@@ -145,6 +426,24 @@ class Stream {
      */
     size_t write(const char* string);
 
+    /**
+     * Write a sequence of bytes to the stream.
+     *
+     * Unlike write(const char*), the data MUST NOT be required to be
+     * null-terminated and MAY contain embedded null bytes. Implementations
+     * MUST NOT copy the data into an intermediate buffer beyond what the
+     * underlying resource requires.
+     *
+     * The caller MAY reuse `data` as soon as this method returns; it MUST
+     * NOT be referenced afterwards.
+     *
+     * @param data The bytes that are to be written.
+     * @param length The number of bytes in `data` to write.
+     * @return The number of bytes written to the stream.
+     * @throws std::runtime_error Unexpected error.
+     */
+    size_t write(const char* data, size_t length);
+
     /**
      * Checks whether or not the stream is readable.
      *
@@ -164,6 +463,101 @@ class Stream {
      */
     const char* read(size_t length);
 
+    /**
+     * Read data from the stream into a caller-provided buffer.
+     *
+     * Bytes MUST be read directly into `buffer` without being copied into
+     * an internal buffer first. The buffer is not null-terminated and MAY
+     * contain embedded null bytes.
+     *
+     * @param buffer The buffer that will receive the data.
+     * @param length Read up to `length` bytes into `buffer`. Fewer than
+     *     `length` bytes may be read if underlying stream call returns fewer
+     *     bytes.
+     * @return The number of bytes read into `buffer`, or 0 if no bytes are
+     *     available.
+     * @throws std::runtime_error Malformed input to a filtered stream or
+     *     unexpected error.
+     */
+    size_t read(char* buffer, size_t length);
+
+    /**
+     * Read data from the stream without blocking.
+     *
+     * @param buffer The buffer that will receive the data.
+     * @param length Read up to `length` bytes into `buffer`.
+     * @param transferred Receives the number of bytes read.
+     * @return STREAM_OK if any bytes were read, STREAM_WOULD_BLOCK if none
+     *     could be read without blocking, or STREAM_END if the end of the
+     *     stream has been reached.
+     * @throws std::runtime_error The stream is not readable or unexpected
+     *     error.
+     */
+    StreamStatus tryRead(char* buffer, size_t length, size_t* transferred);
+
+    /**
+     * Write data to the stream without blocking.
+     *
+     * @param data The bytes that are to be written.
+     * @param length The number of bytes in `data` to write.
+     * @param transferred Receives the number of bytes written.
+     * @return STREAM_OK if any bytes were written, or STREAM_WOULD_BLOCK if
+     *     none could be written without blocking.
+     * @throws std::runtime_error The stream is not writable or unexpected
+     *     error.
+     */
+    StreamStatus tryWrite(
+        const char* data,
+        size_t length,
+        size_t* transferred);
+
+    /**
+     * Retrieve the descriptor underlying the stream.
+     *
+     * Event loops may register the descriptor for readiness notification,
+     * e.g., with `epoll_ctl()`, and MUST then call notifyReady() when it
+     * becomes ready.
+     *
+     * @return The underlying file or socket descriptor, or -1 if the stream
+     *     has none.
+     */
+    int getDescriptor();
+
+    /**
+     * Registers a callback for when the stream becomes ready.
+     *
+     * The callback MUST be called, at most once per registration, when an
+     * operation that previously returned STREAM_WOULD_BLOCK may make
+     * progress for one of the given events. Streams without a descriptor,
+     * such as in-memory or filtered streams, MUST call it themselves; streams
+     * with a descriptor call it from notifyReady().
+     *
+     * The callback MUST NOT be called from within setReadyCallback(), even
+     * if the stream is already ready. It is called on the thread that calls
+     * notifyReady() on this stream or, for a filtered stream, on the stream
+     * it wraps, or on the thread whose operation makes progress possible for
+     * other streams without a descriptor. That thread MAY differ from the
+     * one that registered the callback.
+     *
+     * Readiness that occurred before the registration MAY not be reported.
+     * Callers MUST retry the operation after registering, and cancel the
+     * registration if it no longer blocks.
+     *
+     * @param events The StreamEvent values of interest, combined.
+     * @param callback The function to call, or NULL to cancel the
+     *     registration.
+     * @param context Passed to `callback` unchanged.
+     */
+    void setReadyCallback(int events, StreamCallback callback, void* context);
+
+    /**
+     * Signals that the descriptor of the stream has become ready.
+     *
+     * @see getDescriptor()
+     * @param events The StreamEvent values that occurred, combined.
+     */
+    void notifyReady(int events);
+
     /**
      * Returns the remaining contents from the current position.
      *
@@ -172,6 +566,50 @@ class Stream {
      */
     const char* getContents();
 
+    /**
+     * Returns the remaining contents from the current position and their
+     * length.
+     *
+     * Unlike getContents(), the returned data is not required to be
+     * null-terminated, and MAY contain embedded null bytes.
+     *
+     * @see getContents()
+     * @param length Receives the length of the contents in bytes.
+     * @return The remaining contents.
+     * @throws std::runtime_error Unable to read or unexpected error.
+     */
+    const char* getContents(size_t* length);
+
+    /**
+     * Transfer stream data directly to a file descriptor.
+     *
+     * Copies up to `count` bytes, starting at byte `offset` of the stream, to
+     * the file or socket descriptor `fd`. Implementations SHOULD avoid
+     * copying the data through user space where the platform allows it,
+     * e.g., using `sendfile()` or `splice()` on Linux and `TransmitFile()` on
+     * Windows, and MUST fall back to a buffered read/write loop otherwise.
+     *
+     * The stream position MUST NOT be used or modified by this method.
+     *
+     * If `fd` is non-blocking, this method MUST return as soon as the
+     * descriptor would block, reporting the number of bytes transferred so
+     * far. The caller may resume by calling again with `offset` advanced by
+     * the returned value and `count` reduced accordingly.
+     *
+     * @see https://man7.org/linux/man-pages/man2/sendfile.2.html
+     * @param fd The destination file or socket descriptor.
+     * @param offset Stream offset in bytes at which to begin the transfer.
+     * @param count The maximum number of bytes to transfer, or -1 to
+     *     transfer until the end of the stream.
+     * @return The number of bytes transferred, which may be fewer than
+     *     `count`. Returns -1 if `fd` would block before any byte could be
+     *     transferred, and 0 only if `offset` is at or past the end of the
+     *     stream.
+     * @throws std::runtime_error The stream is not readable or unexpected
+     *     error.
+     */
+    long transferTo(int fd, long offset = 0, long count = -1);
+
     ~Stream();
 };
 
@@ -0,0 +1,140 @@
+#ifndef CSR_HTTP_MESSAGE_STREAMAWAITABLE
+
+#include "Stream.hpp"
+
+/*
+ * Coroutine adapters are only available when CSR_HTTP_MESSAGE_COROUTINES is
+ * defined and the compiler supports C++20. Otherwise, use
+ * Stream::setReadyCallback().
+ */
+#if defined(CSR_HTTP_MESSAGE_COROUTINES) && __cplusplus >= 202002L
+
+#include <coroutine>
+
+namespace Csr {
+namespace Http {
+namespace Message {
+
+/**
+ * Awaitable non-blocking read from a stream.
+ *
+ *     char buffer[65536];
+ *     size_t length = co_await ReadAwaitable(body, buffer, sizeof(buffer));
+ *
+ * The coroutine is suspended while the read would block, and resumed from
+ * the ready callback of the stream.
+ */
+class ReadAwaitable {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Create a new read operation.
+     *
+     * @param stream The stream to read from.
+     * @param buffer The buffer that will receive the data.
+     * @param length Read up to `length` bytes into `buffer`.
+     */
+    ReadAwaitable(Stream* stream, char* buffer, size_t length);
+
+    /**
+     * Attempts the read with Stream::tryRead().
+     *
+     * @return True if the read did not block, false if not.
+     */
+    bool await_ready();
+
+    /**
+     * Registers the ready callback of the stream to resume the coroutine.
+     *
+     * The stream may become ready between await_ready() and the
+     * registration, in which case the callback would never be called. After
+     * registering, the read MUST therefore be retried with Stream::tryRead();
+     * if it does not block, the registration MUST be cancelled and the
+     * coroutine not suspended.
+     *
+     * The callback may run on another thread before the registration is
+     * cancelled. The callback and the cancellation MUST therefore claim the
+     * resumption atomically, and only the first to claim it proceeds: if
+     * the callback already claimed it, this method MUST return true without
+     * retrying, as the coroutine is resumed from the callback. The
+     * coroutine MUST never be resumed twice.
+     *
+     * @param coroutine The coroutine to resume.
+     * @return True if the coroutine is suspended, false if the retried read
+     *     did not block and the coroutine is to be resumed immediately.
+     */
+    bool await_suspend(std::coroutine_handle<> coroutine);
+
+    /**
+     * Completes the read.
+     *
+     * @return The number of bytes read, or 0 at the end of the stream.
+     * @throws std::runtime_error The stream is not readable or unexpected
+     *     error.
+     */
+    size_t await_resume();
+};
+
+/**
+ * Awaitable non-blocking write to a stream.
+ *
+ * @see ReadAwaitable
+ */
+class WriteAwaitable {
+    // Add private members here per implementation.
+
+    public:
+    /**
+     * Create a new write operation.
+     *
+     * @param stream The stream to write to.
+     * @param data The bytes that are to be written.
+     * @param length The number of bytes in `data` to write.
+     */
+    WriteAwaitable(Stream* stream, const char* data, size_t length);
+
+    /**
+     * Attempts the write with Stream::tryWrite().
+     *
+     * @return True if the write did not block, false if not.
+     */
+    bool await_ready();
+
+    /**
+     * Registers the ready callback of the stream to resume the coroutine.
+     *
+     * The stream may become ready between await_ready() and the
+     * registration, in which case the callback would never be called. After
+     * registering, the write MUST therefore be retried with Stream::tryWrite();
+     * if it does not block, the registration MUST be cancelled and the
+     * coroutine not suspended.
+     *
+     * The callback may run on another thread before the registration is
+     * cancelled. The callback and the cancellation MUST therefore claim the
+     * resumption atomically, and only the first to claim it proceeds: if
+     * the callback already claimed it, this method MUST return true without
+     * retrying, as the coroutine is resumed from the callback. The
+     * coroutine MUST never be resumed twice.
+     *
+     * @param coroutine The coroutine to resume.
+     * @return True if the coroutine is suspended, false if the retried write
+     *     did not block and the coroutine is to be resumed immediately.
+     */
+    bool await_suspend(std::coroutine_handle<> coroutine);
+
+    /**
+     * Completes the write.
+     *
+     * @return The number of bytes written.
+     * @throws std::runtime_error The stream is not writable or unexpected
+     *     error.
+     */
+    size_t await_resume();
+};
+
+}}} // Csr::Http::Message
+
+#endif // CSR_HTTP_MESSAGE_COROUTINES
+#define CSR_HTTP_MESSAGE_STREAMAWAITABLE
+#endif // CSR_HTTP_MESSAGE_STREAMAWAITABLE
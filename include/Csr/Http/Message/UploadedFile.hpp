@@ -1,5 +1,6 @@
 #ifndef CSR_HTTP_MESSAGE_UPLOADEDFILE
 
+#include "Allocator.hpp"
 #include "Stream.hpp"
 
 #include <stdlib.h>
@@ -40,6 +41,32 @@ enum UploadError {
     UPLOAD_ERR_EXTENSION = 8
 };
 
+/**
+ * Codes to indicate how an uploaded file was moved.
+ */
+enum MoveStrategy {
+    /** The file has not been moved. */
+    MOVE_NONE = 0,
+
+    /** The file was renamed within the same filesystem. */
+    MOVE_RENAME = 1,
+
+    /** The file was cloned by reference, e.g., using the FICLONE ioctl. */
+    MOVE_REFLINK = 2,
+
+    /** The file was copied in the kernel, e.g., using `copy_file_range()`. */
+    MOVE_COPY_RANGE = 3,
+
+    /** The file was copied through a user space buffer. */
+    MOVE_COPY = 4,
+
+    /**
+     * A file without a path, e.g., created with `O_TMPFILE`, was linked into
+     * the filesystem, e.g., using `linkat()`.
+     */
+    MOVE_LINK = 5
+};
+
 /**
  * Value object representing a file uploaded through an HTTP request.
  */
@@ -68,6 +95,27 @@ class UploadedFile {
         const char* clientFileName = NULL,
         const char* clientMediaType = NULL);
 
+    /**
+     * Create a new uploaded file using the given allocator.
+     *
+     * @see UploadedFile(Stream*, long, UploadError, const char*, const char*)
+     * @param stream The underlying stream representing the uploaded file
+     *     content.
+     * @param size The size of the file in bytes.
+     * @param error The file upload error.
+     * @param clientFileName The filename as provided by the client, if any.
+     * @param clientMediaType The media type as provided by the client, if any.
+     * @param allocator The allocator to use; MUST outlive the uploaded file.
+     * @throws std::invalid_argument The file resource is not readable.
+     */
+    UploadedFile(
+        Stream* stream,
+        long size,
+        UploadError error,
+        const char* clientFileName,
+        const char* clientMediaType,
+        Allocator* allocator);
+
     /**
      * Retrieve a stream representing the uploaded file.
      *
@@ -78,6 +126,9 @@ class UploadedFile {
      * If the moveTo() method has been called previously, this method MUST raise
      * an exception.
      *
+     * Uploads MAY be spooled to a `STREAM_BACKEND_URING` stream; calling code
+     * MUST NOT need to distinguish it from any other stream.
+     *
      * @return Stream representation of the uploaded file.
      * @throws std::runtime_error Stream is unavailable or can't be created.
      */
@@ -100,6 +151,24 @@ class UploadedFile {
      * If you wish to move to a stream, use getStream(), as SAPI operations
      * cannot guarantee writing to stream destinations.
      *
+     * Implementations SHOULD try the following strategies in order, using
+     * the first that succeeds:
+     *
+     * - `rename()`, if the file and `targetPath` are on the same filesystem.
+     * - If the file has no path, e.g., a `STREAM_BACKEND_URING` temporary
+     *   stream created with `O_TMPFILE`, and `targetPath` is on the same
+     *   filesystem, `linkat()` of its descriptor with `AT_EMPTY_PATH`, or of
+     *   its `/proc/self/fd/` entry with `AT_SYMLINK_FOLLOW`. As `linkat()`
+     *   does not replace an existing file, it SHOULD link to a temporary
+     *   name in the target directory and then `rename()` it to
+     *   `targetPath`. This strategy is reported as MOVE_LINK.
+     * - A reflink clone, e.g., using the FICLONE ioctl, if supported.
+     * - An in-kernel copy, e.g., using `copy_file_range()`, if supported.
+     * - A copy through a large buffer, advising the kernel of sequential
+     *   access, e.g., using `posix_fadvise(POSIX_FADV_SEQUENTIAL)`.
+     *
+     * The strategy used MUST be reported by getMoveStrategy().
+     *
      * @param targetPath Path to which to move the uploaded file.
      * @throws std::invalid_argument The targetPath specified is invalid.
      * @throws std::runtime_error Error during the move operation or
@@ -107,6 +176,15 @@ class UploadedFile {
      */
     void moveTo(const char* targetPath);
 
+    /**
+     * Retrieve the strategy by which the uploaded file was moved.
+     *
+     * @see moveTo()
+     * @return One of the move strategies, or MOVE_NONE if moveTo() has not
+     *     completed successfully.
+     */
+    MoveStrategy getMoveStrategy();
+
     /**
      * Retrieve the file size.
      *
@@ -1,5 +1,8 @@
 #ifndef CSR_HTTP_MESSAGE_URI
 
+#include "Allocator.hpp"
+
+#include <stddef.h>
 #include <stdint.h>
 
 namespace Csr {
@@ -19,6 +22,11 @@ namespace Message {
  * For server-side requests, the scheme will typically be discoverable in the
  * server parameters.
  *
+ * Implementations SHOULD keep a single copy of the parsed URI and represent
+ * each component as an offset and length within it, rather than copying each
+ * component into a string of its own. Components MAY be located lazily, on
+ * the first call to a getter.
+ *
  * @see http://tools.ietf.org/html/rfc3986 (the URI specification)
  */
 class Uri {
@@ -28,11 +36,33 @@ class Uri {
     /**
      * Create a new URI.
      *
+     * The URI MUST be validated, and its components SHOULD be located in a
+     * single pass over `uri`.
+     *
      * @param uri The URI to parse.
      * @throws std::invalid_argument The given URI cannot be parsed.
      */
     Uri(const char* uri = "");
 
+    /**
+     * Create a new URI using the given allocator.
+     *
+     * Every component and string returned by the URI MUST be allocated
+     * through `allocator`.
+     *
+     * @param uri The URI to parse.
+     * @param allocator The allocator to use; MUST outlive the URI.
+     * @throws std::invalid_argument The given URI cannot be parsed.
+     */
+    Uri(const char* uri, Allocator* allocator);
+
+    /**
+     * Retrieves the allocator used by the URI.
+     *
+     * @return The allocator given at construction, or the default allocator.
+     */
+    Allocator* getAllocator();
+
     /**
      * Retrieve the scheme component of the URI.
      *
@@ -50,6 +80,18 @@ class Uri {
      */
     const char* getScheme();
 
+    /**
+     * Retrieve the scheme component of the URI and its length.
+     *
+     * Unlike getScheme(), the returned string MAY point into the backing
+     * buffer of the URI and is not required to be null-terminated.
+     *
+     * @see getScheme()
+     * @param length Receives the length of the component in bytes.
+     * @return The URI scheme.
+     */
+    const char* getScheme(size_t* length);
+
     /**
      * Retrieve the authority component of the URI.
      *
@@ -70,6 +112,18 @@ class Uri {
      */
     const char* getAuthority();
 
+    /**
+     * Retrieve the authority component of the URI and its length.
+     *
+     * Unlike getAuthority(), the returned string MAY point into the backing
+     * buffer of the URI and is not required to be null-terminated.
+     *
+     * @see getAuthority()
+     * @param length Receives the length of the component in bytes.
+     * @return The URI authority.
+     */
+    const char* getAuthority(size_t* length);
+
     /**
      * Retrieve the user information component of the URI.
      *
@@ -87,6 +141,18 @@ class Uri {
      */
     const char* getUserInfo();
 
+    /**
+     * Retrieve the user information component of the URI and its length.
+     *
+     * Unlike getUserInfo(), the returned string MAY point into the backing
+     * buffer of the URI and is not required to be null-terminated.
+     *
+     * @see getUserInfo()
+     * @param length Receives the length of the component in bytes.
+     * @return The URI user information.
+     */
+    const char* getUserInfo(size_t* length);
+
     /**
      * Retrieve the host component of the URI.
      *
@@ -100,6 +166,18 @@ class Uri {
      */
     const char* getHost();
 
+    /**
+     * Retrieve the host component of the URI and its length.
+     *
+     * Unlike getHost(), the returned string MAY point into the backing
+     * buffer of the URI and is not required to be null-terminated.
+     *
+     * @see getHost()
+     * @param length Receives the length of the component in bytes.
+     * @return The URI host.
+     */
+    const char* getHost(size_t* length);
+
     /**
      * Retrieve the port component of the URI.
      *
@@ -145,6 +223,18 @@ class Uri {
      */
     const char* getPath();
 
+    /**
+     * Retrieve the path component of the URI and its length.
+     *
+     * Unlike getPath(), the returned string MAY point into the backing
+     * buffer of the URI and is not required to be null-terminated.
+     *
+     * @see getPath()
+     * @param length Receives the length of the component in bytes.
+     * @return The URI path.
+     */
+    const char* getPath(size_t* length);
+
     /**
      * Retrieve the query string of the URI.
      *
@@ -168,6 +258,18 @@ class Uri {
      */
     const char* getQuery();
 
+    /**
+     * Retrieve the query string of the URI and its length.
+     *
+     * Unlike getQuery(), the returned string MAY point into the backing
+     * buffer of the URI and is not required to be null-terminated.
+     *
+     * @see getQuery()
+     * @param length Receives the length of the component in bytes.
+     * @return The URI query string.
+     */
+    const char* getQuery(size_t* length);
+
     /**
      * Retrieve the fragment component of the URI.
      *
@@ -187,6 +289,18 @@ class Uri {
      */
     const char* getFragment();
 
+    /**
+     * Retrieve the fragment component of the URI and its length.
+     *
+     * Unlike getFragment(), the returned string MAY point into the backing
+     * buffer of the URI and is not required to be null-terminated.
+     *
+     * @see getFragment()
+     * @param length Receives the length of the component in bytes.
+     * @return The URI fragment.
+     */
+    const char* getFragment(size_t* length);
+
     /**
      * Change the specified scheme.
      *
@@ -282,6 +396,97 @@ class Uri {
      */
     void setFragment(const char* fragment);
 
+    /**
+     * Return an instance with the specified scheme.
+     *
+     * This method MUST NOT modify the URI. The new URI SHOULD share the
+     * backing buffer of this one until either is modified.
+     *
+     * @see setScheme()
+     * @param scheme The scheme to use with the new instance.
+     * @return A new URI owned by the caller.
+     * @throws std::invalid_argument Invalid or unsupported scheme.
+     */
+    Uri* withScheme(const char* scheme);
+
+    /**
+     * Return an instance with the specified user information.
+     *
+     * This method MUST NOT modify the URI. The new URI SHOULD share the
+     * backing buffer of this one until either is modified.
+     *
+     * @see setUserInfo()
+     * @param user The user name to use for authority.
+     * @param password The password associated with `user`.
+     * @return A new URI owned by the caller.
+     */
+    Uri* withUserInfo(const char* user, const char* password = "");
+
+    /**
+     * Return an instance with the specified host.
+     *
+     * This method MUST NOT modify the URI. The new URI SHOULD share the
+     * backing buffer of this one until either is modified.
+     *
+     * @see setHost()
+     * @param host The hostname to use with the new instance.
+     * @return A new URI owned by the caller.
+     * @throws std::invalid_argument Invalid hostname.
+     */
+    Uri* withHost(const char* host);
+
+    /**
+     * Return an instance with the specified port.
+     *
+     * This method MUST NOT modify the URI. The new URI SHOULD share the
+     * backing buffer of this one until either is modified.
+     *
+     * @see setPort()
+     * @param port The port to use with the new instance; a 0 value
+     *     removes the port information.
+     * @return A new URI owned by the caller.
+     * @throws std::invalid_argument Invalid port number.
+     */
+    Uri* withPort(uint16_t port);
+
+    /**
+     * Return an instance with the specified path.
+     *
+     * This method MUST NOT modify the URI. The new URI SHOULD share the
+     * backing buffer of this one until either is modified.
+     *
+     * @see setPath()
+     * @param path The path to use with the new instance.
+     * @return A new URI owned by the caller.
+     * @throws std::invalid_argument Invalid path.
+     */
+    Uri* withPath(const char* path);
+
+    /**
+     * Return an instance with the specified query string.
+     *
+     * This method MUST NOT modify the URI. The new URI SHOULD share the
+     * backing buffer of this one until either is modified.
+     *
+     * @see setQuery()
+     * @param query The query string to use with the new instance.
+     * @return A new URI owned by the caller.
+     * @throws std::invalid_argument Invalid query string.
+     */
+    Uri* withQuery(const char* query);
+
+    /**
+     * Return an instance with the specified fragment.
+     *
+     * This method MUST NOT modify the URI. The new URI SHOULD share the
+     * backing buffer of this one until either is modified.
+     *
+     * @see setFragment()
+     * @param fragment The fragment to use with the new instance.
+     * @return A new URI owned by the caller.
+     */
+    Uri* withFragment(const char* fragment);
+
     /**
      * Return the string representation as a URI reference.
      *
@@ -302,11 +507,58 @@ class Uri {
      * - If a query is present, it MUST be prefixed by "?".
      * - If a fragment is present, it MUST be prefixed by "#".
      *
+     * If no setter has been called since construction, this method SHOULD
+     * return the string given at construction without rendering a new one,
+     * unless it required normalization.
+     *
+     * Otherwise, the rendered string MUST be cached and returned by
+     * subsequent calls until a setter is called. Implementations MUST cache
+     * the rendering of each component separately, so that a setter only
+     * causes its own component to be rendered again; e.g., setPath() does
+     * not cause the authority to be re-encoded.
+     *
+     * The returned string remains valid until the next setter call or the
+     * destruction of the URI.
+     *
      * @see http://tools.ietf.org/html/rfc3986#section-4.1
      * @return The full URI represented as a string.
      */
     const char* toString();
 
+    /**
+     * Return the string representation as a URI reference and its length.
+     *
+     * @see toString()
+     * @param length Receives the length of the string in bytes.
+     * @return The full URI represented as a string.
+     */
+    const char* toString(size_t* length);
+
+    /**
+     * Retrieve the revision of the URI.
+     *
+     * The revision MUST be incremented by every call to a setter and to
+     * reset(), and MUST NOT otherwise change, so that objects caching strings
+     * derived from the URI (such as a request-target) can detect that they
+     * are stale with an integer comparison.
+     *
+     * @return The number of setter and reset() calls since construction.
+     */
+    unsigned long getRevision();
+
+    /**
+     * Replaces the URI with a newly parsed one.
+     *
+     * The URI MUST be left as if it had just been constructed with `uri`,
+     * except that the revision MUST be incremented rather than restarted (see
+     * getRevision()). Its backing buffer SHOULD be retained for reuse when
+     * large enough.
+     *
+     * @param uri The URI to parse.
+     * @throws std::invalid_argument The given URI cannot be parsed.
+     */
+    void reset(const char* uri = "");
+
     ~Uri();
 };
 